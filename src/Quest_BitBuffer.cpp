@@ -1,5 +1,6 @@
 #include "Quest_BitBuffer.h"
 
+#ifdef ARDUINO
 void printBinaryArray(uint8_t *buffer, uint16_t length, const String &byteDelimiter)
 {
     for (uint8_t i = 0; i < length; i++)
@@ -21,3 +22,71 @@ void printBinaryArray(uint8_t *buffer, uint16_t length, const String &byteDelimi
     }
     Serial.println();
 }
+#endif
+
+#if !(defined(__ARM_FEATURE_CLZ) || defined(__i386__) || defined(__x86_64__))
+static const uint8_t nibbleLeadingZeros[16] = {4, 3, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+#endif
+
+uint8_t countLeadingZeros32(uint32_t value)
+{
+#if defined(__ARM_FEATURE_CLZ) || defined(__i386__) || defined(__x86_64__)
+    if (value == 0)
+    {
+        return 32;
+    }
+    return __builtin_clz(value);
+#else
+    // no CLZ instruction, narrow down to the top nibble and look it up
+    uint8_t leadingZeros = 0;
+    if ((value & 0xFFFF0000) == 0)
+    {
+        leadingZeros += 16;
+        value <<= 16;
+    }
+    if ((value & 0xFF000000) == 0)
+    {
+        leadingZeros += 8;
+        value <<= 8;
+    }
+    if ((value & 0xF0000000) == 0)
+    {
+        leadingZeros += 4;
+        value <<= 4;
+    }
+    return leadingZeros + nibbleLeadingZeros[value >> 28];
+#endif
+}
+
+#if !(defined(__POPCNT__) || defined(__aarch64__))
+#define QBB_POPCOUNT_2(n) n, n + 1, n + 1, n + 2
+#define QBB_POPCOUNT_4(n) QBB_POPCOUNT_2(n), QBB_POPCOUNT_2(n + 1), QBB_POPCOUNT_2(n + 1), QBB_POPCOUNT_2(n + 2)
+#define QBB_POPCOUNT_6(n) QBB_POPCOUNT_4(n), QBB_POPCOUNT_4(n + 1), QBB_POPCOUNT_4(n + 1), QBB_POPCOUNT_4(n + 2)
+static const uint8_t bytePopcount[256] = {QBB_POPCOUNT_6(0), QBB_POPCOUNT_6(1), QBB_POPCOUNT_6(1), QBB_POPCOUNT_6(2)};
+#endif
+
+uint8_t popcount32(uint32_t value)
+{
+#if defined(__POPCNT__) || defined(__aarch64__)
+    return __builtin_popcount(value);
+#else
+    // no POPCNT instruction, count each byte from the table
+    return bytePopcount[value & 0xFF] +
+           bytePopcount[(value >> 8) & 0xFF] +
+           bytePopcount[(value >> 16) & 0xFF] +
+           bytePopcount[value >> 24];
+#endif
+}
+
+#ifdef QBB_STATS
+void resetBitStats(Quest_BitStats *stats)
+{
+    memset(stats, 0, sizeof(Quest_BitStats));
+}
+
+void countBitStatsWidth(Quest_BitStats *stats, uint8_t width)
+{
+    // widths past the largest field share the last count
+    stats->widthCounts[min(width, QBB_STATS_MAX_WIDTH)]++;
+}
+#endif
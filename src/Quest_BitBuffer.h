@@ -7,15 +7,73 @@
  * Format:
  * Reading and writing start at byte 0 in the buffer. Within each byte, bits are
  * read and written from left-most bit to right-most bit.
+ *
+ * Stats:
+ * Build with QBB_STATS defined (for example build_flags = -DQBB_STATS) to
+ * count calls, bits and slow paths in the public stats member of
+ * Quest_BitReader and Quest_BitWriter. Without it the counters do not exist
+ * and the counting compiles away.
  */
 #ifndef quest_bitbuffer_h
 #define quest_bitbuffer_h
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#else
+// host builds (the native test env) get the parts of Arduino.h the library uses
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+template <typename T, typename U>
+inline typename std::common_type<T, U>::type min(T a, U b)
+{
+  return a < b ? a : b;
+}
+
+template <typename T, typename U>
+inline typename std::common_type<T, U>::type max(T a, U b)
+{
+  return a > b ? a : b;
+}
+#endif
 
 #define QBB_FIRST_BIT 0b10000000
 #define QBB_FIRST_BIT_OF_INT 0x80000000
 
+#ifdef ARDUINO
 void printBinaryArray(uint8_t *buffer, uint16_t length, const String &byteDelimiter);
+#endif
+
+// hardware CLZ/POPCNT when the target has them, table lookups otherwise (Cortex-M0)
+uint8_t countLeadingZeros32(uint32_t value);
+uint8_t popcount32(uint32_t value);
+
+#ifdef QBB_STATS
+#define QBB_STATS_MAX_WIDTH 32
+
+struct Quest_BitStats
+{
+  uint32_t bitCalls;
+  uint32_t bitsCalls;
+  uint32_t bufferCalls;
+  uint32_t bitsTransferred;
+  uint32_t fastPathCalls;
+  uint32_t slowPathCalls;
+  uint32_t alignedCalls;
+  uint32_t unalignedCalls;
+  uint32_t rejectedCalls;  // calls that transferred no bits
+  uint32_t truncatedCalls; // reads clamped to the bits that were left
+  uint32_t widthCounts[QBB_STATS_MAX_WIDTH + 1];
+};
+
+void resetBitStats(Quest_BitStats *stats);
+void countBitStatsWidth(Quest_BitStats *stats, uint8_t width);
+
+#define QBB_STAT(statement) statement
+#else
+#define QBB_STAT(statement)
+#endif
 
 #endif
@@ -4,6 +4,7 @@ Quest_BitReader::Quest_BitReader(uint8_t *buffer, uint8_t bufferLength)
 {
     this->buffer = buffer;
     this->bufferLength = bufferLength;
+    QBB_STAT(resetBitStats(&stats));
 
     reset(bufferLength * 8);
 }
@@ -24,11 +25,25 @@ uint16_t Quest_BitReader::bitsRemaining()
     return bitCount - bitPosition;
 }
 
+bool Quest_BitReader::seek(uint16_t position)
+{
+    // position should never exceed the bits available
+    uint16_t newPosition = min(position, bitCount);
+    bitPosition = newPosition;
+    bufferPosition = newPosition >> 3;
+    bitMask = QBB_FIRST_BIT >> (newPosition & 0b111);
+
+    return newPosition == position;
+}
+
 bool Quest_BitReader::readBit()
 {
+    QBB_STAT(stats.bitCalls++);
+
     if (bitPosition >= bitCount)
     {
         // already read all available bits
+        QBB_STAT(stats.rejectedCalls++);
         return 0;
     }
 
@@ -41,23 +56,31 @@ bool Quest_BitReader::readBit()
         bitMask = QBB_FIRST_BIT;
     }
     bitPosition++;
+    QBB_STAT(stats.bitsTransferred++);
 
     return bit;
 }
 
 uint32_t Quest_BitReader::readBits(uint8_t bitsToRead)
 {
+    QBB_STAT(stats.bitsCalls++);
+    QBB_STAT(countBitStatsWidth(&stats, bitsToRead));
+    QBB_STAT(bitMask == QBB_FIRST_BIT ? stats.alignedCalls++ : stats.unalignedCalls++);
+
     if (bitPosition >= bitCount)
     {
         // already read all available bits
+        QBB_STAT(stats.rejectedCalls++);
         return 0;
     }
 
     // do not read more bits than available
     if (bitPosition + bitsToRead > bitCount)
     {
+        QBB_STAT(stats.truncatedCalls++);
         bitsToRead = bitCount - bitPosition;
     }
+    QBB_STAT(stats.bitsTransferred += bitsToRead);
 
     uint32_t readBits = 0;
     uint8_t bufferByte = buffer[bufferPosition];
@@ -89,23 +112,31 @@ uint32_t Quest_BitReader::readBits(uint8_t bitsToRead)
 
 uint16_t Quest_BitReader::readBuffer(uint8_t *destinationBuffer, uint16_t bitsToRead)
 {
+    QBB_STAT(stats.bufferCalls++);
+    QBB_STAT(bitMask == QBB_FIRST_BIT ? stats.alignedCalls++ : stats.unalignedCalls++);
+
     if (bitPosition >= bitCount)
     {
         // already read all available bits
+        QBB_STAT(stats.rejectedCalls++);
         return 0;
     }
 
     // do not read more bits than available
     if (bitPosition + bitsToRead > bitCount)
     {
+        QBB_STAT(stats.truncatedCalls++);
         bitsToRead = bitCount - bitPosition;
     }
+    QBB_STAT(stats.bitsTransferred += bitsToRead);
 
     // if the read is byte-aligned, can copy much faster
     if (bitMask == QBB_FIRST_BIT)
     {
+        QBB_STAT(stats.fastPathCalls++);
         return fastReadBuffer(destinationBuffer, bitsToRead);
     }
+    QBB_STAT(stats.slowPathCalls++);
 
     uint8_t readBits = 0;
     uint8_t bufferByte = buffer[bufferPosition];
@@ -173,3 +204,117 @@ uint16_t Quest_BitReader::fastReadBuffer(uint8_t *destinationBuffer, uint16_t bi
     bitPosition += bitsToRead;
     return bitsToRead;
 }
+
+uint16_t Quest_BitReader::countLeadingZeros()
+{
+    return scanForBit(bitPosition, true) - bitPosition;
+}
+
+uint16_t Quest_BitReader::countLeadingOnes()
+{
+    return scanForBit(bitPosition, false) - bitPosition;
+}
+
+uint16_t Quest_BitReader::findNextSetBit(uint16_t fromPosition)
+{
+    return scanForBit(fromPosition, true);
+}
+
+uint16_t Quest_BitReader::findNextClearBit(uint16_t fromPosition)
+{
+    return scanForBit(fromPosition, false);
+}
+
+uint16_t Quest_BitReader::popcount(uint16_t bitsToCount)
+{
+    // do not count more bits than available
+    if (bitsToCount > bitsRemaining())
+    {
+        bitsToCount = bitsRemaining();
+    }
+
+    uint16_t setBits = 0;
+    uint16_t position = bitPosition;
+    while (bitsToCount > 0)
+    {
+        uint8_t bitsInWord;
+        uint32_t word = peekWord(position, &bitsInWord);
+        if (bitsInWord > bitsToCount)
+        {
+            // clear the bits past the end of the range
+            bitsInWord = bitsToCount;
+            word &= ~(0xFFFFFFFF >> bitsInWord);
+        }
+
+        setBits += popcount32(word);
+        position += bitsInWord;
+        bitsToCount -= bitsInWord;
+    }
+
+    return setBits;
+}
+
+uint32_t Quest_BitReader::peekWord(uint16_t position, uint8_t *bitsInWord)
+{
+    if (position >= bitCount)
+    {
+        // nothing to read at or past the end
+        *bitsInWord = 0;
+        return 0;
+    }
+
+    // load the 4 bytes starting at the position, without reading past the buffer
+    uint8_t wordPosition = position >> 3;
+    uint32_t word = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        word <<= 8;
+        if (wordPosition + i < bufferLength)
+        {
+            word |= buffer[wordPosition + i];
+        }
+    }
+
+    // left-align the bit at the position, the low bits become 0's
+    uint8_t bitOffset = position & 0b111;
+    word <<= bitOffset;
+    *bitsInWord = 32 - bitOffset;
+
+    // clear any bits beyond the bits available
+    uint16_t bitsAvailable = bitCount - position;
+    if (bitsAvailable < *bitsInWord)
+    {
+        *bitsInWord = bitsAvailable;
+        word &= ~(0xFFFFFFFF >> bitsAvailable);
+    }
+
+    return word;
+}
+
+uint16_t Quest_BitReader::scanForBit(uint16_t fromPosition, bool bit)
+{
+    uint16_t position = fromPosition;
+    while (position < bitCount)
+    {
+        uint8_t bitsInWord;
+        uint32_t word = peekWord(position, &bitsInWord);
+        if (!bit)
+        {
+            // look for a set bit in the inverted word, ignoring the unused low bits
+            word = ~word;
+            if (bitsInWord < 32)
+            {
+                word &= ~(0xFFFFFFFF >> bitsInWord);
+            }
+        }
+
+        if (word != 0)
+        {
+            return position + countLeadingZeros32(word);
+        }
+        position += bitsInWord;
+    }
+
+    // no matching bit was found
+    return bitCount;
+}
@@ -13,21 +13,39 @@ public:
 
   uint16_t bitCount;
   uint16_t bitPosition;
+#ifdef QBB_STATS
+  Quest_BitStats stats;
+#endif
 
   bool reset(uint16_t bitsAvailable);
   uint16_t bitsRemaining();
+  bool seek(uint16_t position);
 
   bool readBit();
   uint32_t readBits(uint8_t bitsToRead);
   uint16_t readBuffer(uint8_t *destinationBuffer, uint16_t bitsToRead);
 
+  // scans work a word at a time and do not move the read position
+  uint16_t countLeadingZeros();
+  uint16_t countLeadingOnes();
+  uint16_t findNextSetBit(uint16_t fromPosition);
+  uint16_t findNextClearBit(uint16_t fromPosition);
+  uint16_t popcount(uint16_t bitsToCount);
+
+  // the bits from position left-aligned, bitsInWord of them are valid (25 to 32, fewer at the end, 0 past it)
+  uint32_t peekWord(uint16_t position, uint8_t *bitsInWord);
+
 private:
+  // the delta decoder's host kernels unpack straight from the buffer
+  friend class Quest_DeltaDecoder;
+
   uint8_t *buffer;
   uint8_t bufferLength;
   uint8_t bufferPosition;
   uint8_t bitMask;
 
   uint16_t fastReadBuffer(uint8_t *destinationBuffer, uint16_t bitsToRead);
+  uint16_t scanForBit(uint16_t fromPosition, bool bit);
 };
 
 #endif
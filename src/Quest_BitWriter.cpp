@@ -4,6 +4,7 @@ Quest_BitWriter::Quest_BitWriter(uint8_t *buffer, uint8_t bufferLength)
 {
     this->buffer = buffer;
     this->bufferLength = bufferLength;
+    QBB_STAT(resetBitStats(&stats));
 
     reset();
 }
@@ -27,24 +28,34 @@ uint16_t Quest_BitWriter::bitsRemaining()
 
 bool Quest_BitWriter::writeBit(bool bit)
 {
+    QBB_STAT(stats.bitCalls++);
+
     // make sure there is enough room in the buffer
     if (bitsRemaining() == 0)
     {
+        QBB_STAT(stats.rejectedCalls++);
         return false;
     }
 
     writeBitInternal(bit);
+    QBB_STAT(stats.bitsTransferred++);
 
     return true;
 }
 
 bool Quest_BitWriter::writeBits(uint32_t bits, uint8_t bitsToWrite)
 {
+    QBB_STAT(stats.bitsCalls++);
+    QBB_STAT(countBitStatsWidth(&stats, bitsToWrite));
+    QBB_STAT(bitMask == QBB_FIRST_BIT ? stats.alignedCalls++ : stats.unalignedCalls++);
+
     // make sure there is enough room in the buffer
     if (bitsToWrite > bitsRemaining())
     {
+        QBB_STAT(stats.rejectedCalls++);
         return false;
     }
+    QBB_STAT(stats.bitsTransferred += bitsToWrite);
 
     // shift the bits so the first bit to write is left-most
     bits <<= (32 - bitsToWrite);
@@ -61,11 +72,19 @@ bool Quest_BitWriter::writeBits(uint32_t bits, uint8_t bitsToWrite)
 
 bool Quest_BitWriter::writeBuffer(uint8_t *sourceBuffer, uint16_t bitsToWrite)
 {
+    QBB_STAT(stats.bufferCalls++);
+    QBB_STAT(bitMask == QBB_FIRST_BIT ? stats.alignedCalls++ : stats.unalignedCalls++);
+
     // make sure there is enough room in the buffer
     if (bitsToWrite > bitsRemaining())
     {
+        QBB_STAT(stats.rejectedCalls++);
         return false;
     }
+    QBB_STAT(stats.bitsTransferred += bitsToWrite);
+
+    // there is no byte copy for writes yet, every buffer is written bit by bit
+    QBB_STAT(stats.slowPathCalls++);
 
     uint8_t sourceBits = sourceBuffer[0];
     uint8_t sourceBufferPosition = 0;
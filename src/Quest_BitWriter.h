@@ -12,6 +12,9 @@ public:
   Quest_BitWriter(uint8_t *buffer, uint8_t bufferLength);
 
   uint16_t bitPosition;
+#ifdef QBB_STATS
+  Quest_BitStats stats;
+#endif
 
   void reset();
   uint16_t bitsWritten();
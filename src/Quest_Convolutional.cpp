@@ -0,0 +1,186 @@
+#include "Quest_Convolutional.h"
+
+// the 2 coded bits for each value of the 3 bit shift register (input bit first)
+static const uint8_t branchOutputs[8] = {0b00, 0b11, 0b10, 0b01, 0b11, 0b00, 0b01, 0b10};
+
+#define QCC_DECODED_BIT 0x10
+#define QCC_UNREACHABLE_METRIC 0x3FFF
+
+#if !defined(QCC_SCALAR_ACS) && (defined(__x86_64__) || defined(__aarch64__))
+#define QCC_PACKED_ACS
+#endif
+
+#ifdef QCC_PACKED_ACS
+// one 16 bit lane per state, metrics stay below the top bit of each lane
+#define QCC_LANE_MASK 0x000000000000FFFFULL
+#define QCC_LANE_ONES 0x0001000100010001ULL
+#define QCC_LANE_TOP_BITS 0x8000800080008000ULL
+#define QCC_LANE_BITS 16
+
+// a path metric grows by at most QCC_CODED_BITS per step, the compare needs it below 0x8000
+#if QCC_CODED_BITS * (QCC_MAX_DECODE_BITS + QCC_TAIL_BITS + 1) >= 0x8000
+#error "QCC_MAX_DECODE_BITS is too large for the packed decoder, define QCC_SCALAR_ACS"
+#endif
+#endif
+
+Quest_ConvolutionalEncoder::Quest_ConvolutionalEncoder(Quest_BitWriter *writer)
+{
+    this->writer = writer;
+
+    reset();
+}
+
+void Quest_ConvolutionalEncoder::reset()
+{
+    state = 0;
+}
+
+bool Quest_ConvolutionalEncoder::writeBit(bool bit)
+{
+    return writeBits(bit, 1);
+}
+
+bool Quest_ConvolutionalEncoder::writeBits(uint32_t bits, uint8_t bitsToWrite)
+{
+    // make sure there is enough room for the coded bits
+    if (bitsToWrite * QCC_CODED_BITS > writer->bitsRemaining())
+    {
+        return false;
+    }
+
+    for (uint8_t i = bitsToWrite; i > 0; i--)
+    {
+        writeBitInternal((bits >> (i - 1)) & 1);
+    }
+
+    return true;
+}
+
+bool Quest_ConvolutionalEncoder::flush()
+{
+    // the tail bits return the encoder to state 0
+    return writeBits(0, QCC_TAIL_BITS);
+}
+
+void Quest_ConvolutionalEncoder::writeBitInternal(bool bit)
+{
+    uint8_t shiftRegister = (bit << 2) | state;
+    writer->writeBits(branchOutputs[shiftRegister], QCC_CODED_BITS);
+    state = shiftRegister >> 1;
+}
+
+Quest_ConvolutionalDecoder::Quest_ConvolutionalDecoder(Quest_BitReader *reader)
+{
+    this->reader = reader;
+    this->errorMetric = 0;
+}
+
+uint16_t Quest_ConvolutionalDecoder::decode(Quest_BitWriter *destination, uint16_t bitsToDecode)
+{
+    uint16_t steps = bitsToDecode + QCC_TAIL_BITS;
+    if (bitsToDecode > QCC_MAX_DECODE_BITS ||
+        steps * QCC_CODED_BITS > reader->bitsRemaining() ||
+        bitsToDecode > destination->bitsRemaining())
+    {
+        return 0;
+    }
+
+#ifdef QCC_PACKED_ACS
+    // branch metrics for each received pair, from the previous states with a 0 and a 1 oldest bit
+    uint64_t branchMetrics0[1 << QCC_CODED_BITS] = {0};
+    uint64_t branchMetrics1[1 << QCC_CODED_BITS] = {0};
+    for (uint8_t received = 0; received < (1 << QCC_CODED_BITS); received++)
+    {
+        for (uint8_t state = 0; state < QCC_STATES; state++)
+        {
+            uint8_t shiftRegister = ((state >> 1) << 2) | ((state & 1) << 1);
+            uint8_t errors0 = received ^ branchOutputs[shiftRegister];
+            uint8_t errors1 = received ^ branchOutputs[shiftRegister | 1];
+            branchMetrics0[received] |= (uint64_t)((errors0 >> 1) + (errors0 & 1)) << (state * QCC_LANE_BITS);
+            branchMetrics1[received] |= (uint64_t)((errors1 >> 1) + (errors1 & 1)) << (state * QCC_LANE_BITS);
+        }
+    }
+
+    // the encoder always starts in state 0
+    uint64_t metrics = (QCC_UNREACHABLE_METRIC * QCC_LANE_ONES) & ~QCC_LANE_MASK;
+
+    for (uint16_t step = 0; step < steps; step++)
+    {
+        uint8_t received = reader->readBits(QCC_CODED_BITS);
+
+        // states 0-3 come from previous states 0,2,0,2 with a 0 oldest bit, 1,3,1,3 with a 1
+        uint64_t previous0 = (metrics & QCC_LANE_MASK) | ((metrics >> 16) & (QCC_LANE_MASK << 16));
+        uint64_t previous1 = ((metrics >> 16) & QCC_LANE_MASK) | ((metrics >> 32) & (QCC_LANE_MASK << 16));
+        uint64_t metrics0 = (previous0 | (previous0 << 32)) + branchMetrics0[received];
+        uint64_t metrics1 = (previous1 | (previous1 << 32)) + branchMetrics1[received];
+
+        // the top bit of a lane is set where metrics1 < metrics0, with no borrow between lanes
+        uint64_t selected1 = ((metrics0 | QCC_LANE_TOP_BITS) - (metrics1 + QCC_LANE_ONES)) & QCC_LANE_TOP_BITS;
+        uint64_t selectMask = (selected1 >> 15) * QCC_LANE_MASK;
+        metrics = (metrics1 & selectMask) | (metrics0 & ~selectMask);
+
+        decisions[step] = ((selected1 >> 15) & 0b0001) |
+                          ((selected1 >> 30) & 0b0010) |
+                          ((selected1 >> 45) & 0b0100) |
+                          ((selected1 >> 60) & 0b1000);
+    }
+
+    errorMetric = metrics & QCC_LANE_MASK;
+#else
+    // the encoder always starts in state 0
+    uint16_t metrics[QCC_STATES] = {0, QCC_UNREACHABLE_METRIC, QCC_UNREACHABLE_METRIC, QCC_UNREACHABLE_METRIC};
+    uint16_t nextMetrics[QCC_STATES];
+
+    for (uint16_t step = 0; step < steps; step++)
+    {
+        uint8_t received = reader->readBits(QCC_CODED_BITS);
+        uint8_t stepDecisions = 0;
+
+        // add-compare-select, each state has 2 previous states that differ in the oldest bit
+        for (uint8_t state = 0; state < QCC_STATES; state++)
+        {
+            uint8_t previousState = (state & 1) << 1;
+            uint8_t shiftRegister = ((state >> 1) << 2) | previousState;
+
+            uint8_t errors0 = received ^ branchOutputs[shiftRegister];
+            uint8_t errors1 = received ^ branchOutputs[shiftRegister | 1];
+            uint16_t metric0 = metrics[previousState] + (errors0 >> 1) + (errors0 & 1);
+            uint16_t metric1 = metrics[previousState | 1] + (errors1 >> 1) + (errors1 & 1);
+
+            if (metric1 < metric0)
+            {
+                nextMetrics[state] = metric1;
+                stepDecisions |= 1 << state;
+            }
+            else
+            {
+                nextMetrics[state] = metric0;
+            }
+        }
+
+        memcpy(metrics, nextMetrics, sizeof(metrics));
+        decisions[step] = stepDecisions;
+    }
+
+    errorMetric = metrics[0];
+#endif
+
+    // the tail bits end the block in state 0, trace the surviving path back from there
+    uint8_t state = 0;
+    for (uint16_t step = steps; step > 0; step--)
+    {
+        uint8_t stepDecisions = decisions[step - 1];
+        if (state >> 1)
+        {
+            decisions[step - 1] |= QCC_DECODED_BIT;
+        }
+        state = ((state & 1) << 1) | ((stepDecisions >> state) & 1);
+    }
+
+    for (uint16_t step = 0; step < bitsToDecode; step++)
+    {
+        destination->writeBit(decisions[step] & QCC_DECODED_BIT);
+    }
+
+    return bitsToDecode;
+}
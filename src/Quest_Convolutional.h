@@ -0,0 +1,68 @@
+/* Quest_Convolutional.h Quest Convolutional Code Library
+ * Forward error correction with a rate 1/2 convolutional code and a hard
+ * decision Viterbi decoder.
+ *
+ * Format:
+ * The code has constraint length 3 with generators 7 and 5 (octal). Each data
+ * bit is written as 2 coded bits. flush() ends a block with 2 tail bits of 0's
+ * so the decoder finishes in a known state, which makes a block of N data bits
+ * take 2 * (N + 2) coded bits.
+ *
+ * Decoding:
+ * The decoder keeps one byte of decisions per data bit for the traceback, so it
+ * holds QCC_MAX_DECODE_BITS + QCC_TAIL_BITS bytes and should be kept global
+ * rather than on the stack. errorMetric is the number of coded bits that did
+ * not match the decoded path.
+ *
+ * On 64-bit hosts the 4 path metrics are packed into one 64-bit word and the
+ * add-compare-select for all states runs at once. Define QCC_SCALAR_ACS to
+ * use the per-state loop the boards run instead. Each packed metric must stay
+ * below 0x8000, which limits QCC_MAX_DECODE_BITS to about 16000 on hosts.
+ */
+#ifndef quest_convolutional_h
+#define quest_convolutional_h
+
+#include "Quest_BitWriter.h"
+#include "Quest_BitReader.h"
+
+#ifndef QCC_MAX_DECODE_BITS
+#define QCC_MAX_DECODE_BITS 512
+#endif
+
+#define QCC_CODED_BITS 2
+#define QCC_TAIL_BITS 2
+#define QCC_STATES 4
+
+class Quest_ConvolutionalEncoder
+{
+public:
+  Quest_ConvolutionalEncoder(Quest_BitWriter *writer);
+
+  void reset();
+
+  bool writeBit(bool bit);
+  bool writeBits(uint32_t bits, uint8_t bitsToWrite);
+  bool flush();
+
+private:
+  Quest_BitWriter *writer;
+  uint8_t state;
+
+  void writeBitInternal(bool bit);
+};
+
+class Quest_ConvolutionalDecoder
+{
+public:
+  Quest_ConvolutionalDecoder(Quest_BitReader *reader);
+
+  uint16_t errorMetric;
+
+  uint16_t decode(Quest_BitWriter *destination, uint16_t bitsToDecode);
+
+private:
+  Quest_BitReader *reader;
+  uint8_t decisions[QCC_MAX_DECODE_BITS + QCC_TAIL_BITS];
+};
+
+#endif
@@ -0,0 +1,31 @@
+/* Quest_DeltaCodec.h Quest Delta Codec Library
+ * Packs blocks of 16-bit samples as small residuals.
+ *
+ * See Quest_DeltaEncoder.h to write blocks and Quest_DeltaDecoder.h to
+ * read blocks.
+ *
+ * Format:
+ * Each block starts with a header of the sample count (8 bits), the mode
+ * (1 bit), the base value (16 bits) and the residual width (5 bits), followed
+ * by the residuals packed at that width.
+ *
+ * Frame of reference mode stores every sample minus the smallest sample, which
+ * is the base. Delta mode stores the first sample as the base and then each
+ * sample minus the previous sample, zigzag encoded so small negative steps
+ * stay small. The encoder picks whichever mode packs the block in fewer bits.
+ */
+#ifndef quest_deltacodec_h
+#define quest_deltacodec_h
+
+#include "Quest_BitBuffer.h"
+
+#define QDC_MODE_FRAME_OF_REFERENCE 0
+#define QDC_MODE_DELTA 1
+
+#define QDC_COUNT_BITS 8
+#define QDC_MODE_BITS 1
+#define QDC_BASE_BITS 16
+#define QDC_WIDTH_BITS 5
+#define QDC_HEADER_BITS (QDC_COUNT_BITS + QDC_MODE_BITS + QDC_BASE_BITS + QDC_WIDTH_BITS)
+
+#endif
@@ -0,0 +1,177 @@
+#include "Quest_DeltaDecoder.h"
+
+// steps are zigzag encoded, odd residuals are negative
+static inline int32_t zigzagStep(uint32_t residual)
+{
+    return (residual & 1) ? -(int32_t)((residual + 1) >> 1) : (int32_t)(residual >> 1);
+}
+
+#ifdef QDC_UNPACK_KERNELS
+typedef void (*Quest_UnpackKernel)(const uint8_t *bytes, uint8_t bitOffset, uint8_t groupCount, uint32_t *residuals);
+
+template <uint8_t width>
+static void unpackKernel(const uint8_t *bytes, uint8_t bitOffset, uint8_t groupCount, uint32_t *residuals)
+{
+    for (uint8_t group = 0; group < groupCount; group++)
+    {
+        // residual i of the group is in the 4 bytes from (i * width) / 8, the offset and
+        // width together are at most 31 bits so one word always holds it
+        for (uint8_t i = 0; i < QDC_KERNEL_GROUP; i++)
+        {
+            const uint8_t *word = bytes + ((i * width) >> 3);
+            uint32_t bits = ((uint32_t)word[0] << 24) | ((uint32_t)word[1] << 16) | ((uint32_t)word[2] << 8) | word[3];
+            residuals[i] = (bits << (((i * width) & 0b111) + bitOffset)) >> (32 - width);
+        }
+        bytes += width;
+        residuals += QDC_KERNEL_GROUP;
+    }
+}
+
+template <>
+void unpackKernel<0>(const uint8_t *, uint8_t, uint8_t groupCount, uint32_t *residuals)
+{
+    memset(residuals, 0, groupCount * QDC_KERNEL_GROUP * sizeof(uint32_t));
+}
+
+static const Quest_UnpackKernel unpackKernels[QDC_MAX_KERNEL_WIDTH + 1] = {
+    unpackKernel<0>, unpackKernel<1>, unpackKernel<2>, unpackKernel<3>,
+    unpackKernel<4>, unpackKernel<5>, unpackKernel<6>, unpackKernel<7>,
+    unpackKernel<8>, unpackKernel<9>, unpackKernel<10>, unpackKernel<11>,
+    unpackKernel<12>, unpackKernel<13>, unpackKernel<14>, unpackKernel<15>,
+    unpackKernel<16>, unpackKernel<17>};
+#endif
+
+Quest_DeltaDecoder::Quest_DeltaDecoder(Quest_BitReader *reader)
+{
+    this->reader = reader;
+    this->window = 0;
+    this->windowBits = 0;
+    this->windowPosition = 0;
+}
+
+uint8_t Quest_DeltaDecoder::readBlock(int16_t *values, uint8_t maxCount)
+{
+    if (reader->bitsRemaining() < QDC_HEADER_BITS)
+    {
+        return 0;
+    }
+
+    uint8_t count = reader->readBits(QDC_COUNT_BITS);
+    uint8_t mode = reader->readBits(QDC_MODE_BITS);
+    int16_t base = (int16_t)reader->readBits(QDC_BASE_BITS);
+    uint8_t residualWidth = reader->readBits(QDC_WIDTH_BITS);
+
+    // make sure the block fits and all of its residuals are available
+    uint8_t residualCount = (mode == QDC_MODE_DELTA && count > 0) ? count - 1 : count;
+    if (count > maxCount || (uint16_t)residualCount * residualWidth > reader->bitsRemaining())
+    {
+        return 0;
+    }
+
+    // the window starts empty at the first residual
+    window = 0;
+    windowBits = 0;
+    windowPosition = reader->bitPosition;
+
+#ifdef QDC_UNPACK_KERNELS
+    unpackResiduals(residualCount, residualWidth);
+
+    if (mode == QDC_MODE_DELTA)
+    {
+        // rebuild the samples from the running sum of the steps
+        int16_t value = base;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (i > 0)
+            {
+                value = (int16_t)(value + zigzagStep(residuals[i - 1]));
+            }
+            values[i] = value;
+        }
+    }
+    else
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            values[i] = (int16_t)(base + residuals[i]);
+        }
+    }
+#else
+    if (mode == QDC_MODE_DELTA)
+    {
+        // rebuild the samples from the running sum of the steps
+        int16_t value = base;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (i > 0)
+            {
+                value = (int16_t)(value + zigzagStep(readResidual(residualWidth)));
+            }
+            values[i] = value;
+        }
+    }
+    else
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            values[i] = (int16_t)(base + readResidual(residualWidth));
+        }
+    }
+#endif
+
+    // move the reader to just after the last residual used
+    reader->seek(windowPosition - windowBits);
+
+    return count;
+}
+
+#ifdef QDC_UNPACK_KERNELS
+void Quest_DeltaDecoder::unpackResiduals(uint8_t residualCount, uint8_t residualWidth)
+{
+    // kernels load whole words, so stop at groups that would load past the buffer
+    uint8_t groupCount = residualWidth <= QDC_MAX_KERNEL_WIDTH ? residualCount / QDC_KERNEL_GROUP : 0;
+    uint16_t startByte = windowPosition >> 3;
+    while (groupCount > 0 && startByte + groupCount * residualWidth + 4 > reader->bufferLength)
+    {
+        groupCount--;
+    }
+
+    uint8_t unpackedCount = groupCount * QDC_KERNEL_GROUP;
+    if (groupCount > 0)
+    {
+        unpackKernels[residualWidth](&reader->buffer[startByte], windowPosition & 0b111, groupCount, residuals);
+        windowPosition += unpackedCount * residualWidth;
+    }
+
+    // the window picks up after the last whole group
+    for (uint8_t i = unpackedCount; i < residualCount; i++)
+    {
+        residuals[i] = readResidual(residualWidth);
+    }
+}
+#endif
+
+uint32_t Quest_DeltaDecoder::readResidual(uint8_t residualWidth)
+{
+    if (residualWidth == 0)
+    {
+        return 0;
+    }
+
+    // append whole words below the bits already in the window
+    while (windowBits < residualWidth)
+    {
+        uint8_t bitsInWord;
+        uint32_t word = reader->peekWord(windowPosition, &bitsInWord);
+        window |= (uint64_t)word << (32 - windowBits);
+        windowBits += bitsInWord;
+        windowPosition += bitsInWord;
+    }
+
+    // the residual is at the top of the window
+    uint32_t residual = window >> (64 - residualWidth);
+    window <<= residualWidth;
+    windowBits -= residualWidth;
+
+    return residual;
+}
@@ -0,0 +1,50 @@
+/* Quest_DeltaDecoder.h Quest Delta Decoder Library
+ * Reads blocks of 16-bit samples from a Quest_BitReader.
+ *
+ * readBlock() returns the number of samples read, or 0 if the block is
+ * larger than the destination or the reader runs out of bits.
+ *
+ * Residuals are unpacked from a 64-bit window refilled a word at a time, so
+ * each residual costs a shift and a mask rather than a loop over its bits.
+ *
+ * On 64-bit hosts the residuals of a block are unpacked into an array first,
+ * whole groups of 8 by a kernel for each residual width. 8 residuals fill
+ * exactly width bytes, so every kernel has fixed byte offsets and shifts and
+ * no per-block setup. The samples are then rebuilt from the array. Define
+ * QDC_WINDOW_UNPACK to read each residual from the window like the boards.
+ */
+#ifndef quest_deltadecoder_h
+#define quest_deltadecoder_h
+
+#include "Quest_DeltaCodec.h"
+#include "Quest_BitReader.h"
+
+#if !defined(QDC_WINDOW_UNPACK) && (defined(__x86_64__) || defined(__aarch64__))
+#define QDC_UNPACK_KERNELS
+#define QDC_KERNEL_GROUP 8
+#define QDC_MAX_KERNEL_WIDTH 17
+#endif
+
+class Quest_DeltaDecoder
+{
+public:
+  Quest_DeltaDecoder(Quest_BitReader *reader);
+
+  uint8_t readBlock(int16_t *values, uint8_t maxCount);
+
+private:
+  Quest_BitReader *reader;
+  uint64_t window;
+  uint8_t windowBits;
+  uint16_t windowPosition;
+
+#ifdef QDC_UNPACK_KERNELS
+  uint32_t residuals[UINT8_MAX];
+
+  void unpackResiduals(uint8_t residualCount, uint8_t residualWidth);
+#endif
+
+  uint32_t readResidual(uint8_t residualWidth);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "Quest_DeltaEncoder.h"
+
+static uint8_t bitWidth(uint32_t value)
+{
+    return 32 - countLeadingZeros32(value);
+}
+
+static uint32_t zigzag(int32_t value)
+{
+    return value < 0 ? ((uint32_t)(-value) << 1) - 1 : (uint32_t)value << 1;
+}
+
+Quest_DeltaEncoder::Quest_DeltaEncoder(Quest_BitWriter *writer)
+{
+    this->writer = writer;
+}
+
+uint16_t Quest_DeltaEncoder::blockBits(const int16_t *values, uint8_t count)
+{
+    chooseMode(values, count);
+
+    uint8_t residualCount = (mode == QDC_MODE_DELTA) ? count - 1 : count;
+    return QDC_HEADER_BITS + residualCount * residualWidth;
+}
+
+bool Quest_DeltaEncoder::writeBlock(const int16_t *values, uint8_t count)
+{
+    // make sure there is enough room for the whole block
+    if (blockBits(values, count) > writer->bitsRemaining())
+    {
+        return false;
+    }
+
+    writer->writeBits(count, QDC_COUNT_BITS);
+    writer->writeBits(mode, QDC_MODE_BITS);
+    writer->writeBits((uint16_t)base, QDC_BASE_BITS);
+    writer->writeBits(residualWidth, QDC_WIDTH_BITS);
+
+    if (residualWidth == 0)
+    {
+        // every residual is 0, the header is enough
+        return true;
+    }
+
+    if (mode == QDC_MODE_DELTA)
+    {
+        for (uint8_t i = 1; i < count; i++)
+        {
+            writer->writeBits(zigzag((int32_t)values[i] - values[i - 1]), residualWidth);
+        }
+    }
+    else
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            writer->writeBits((int32_t)values[i] - base, residualWidth);
+        }
+    }
+
+    return true;
+}
+
+void Quest_DeltaEncoder::chooseMode(const int16_t *values, uint8_t count)
+{
+    if (count == 0)
+    {
+        mode = QDC_MODE_FRAME_OF_REFERENCE;
+        base = 0;
+        residualWidth = 0;
+        return;
+    }
+
+    // find the widest residual for each mode in a single pass
+    int16_t minimum = values[0];
+    int16_t maximum = values[0];
+    uint32_t maximumDelta = 0;
+    for (uint8_t i = 1; i < count; i++)
+    {
+        minimum = min(minimum, values[i]);
+        maximum = max(maximum, values[i]);
+        maximumDelta = max(maximumDelta, zigzag((int32_t)values[i] - values[i - 1]));
+    }
+
+    uint8_t referenceWidth = bitWidth((int32_t)maximum - minimum);
+    uint8_t deltaWidth = bitWidth(maximumDelta);
+
+    // delta mode stores the first sample in the header, so it has one less residual
+    if ((uint16_t)(count - 1) * deltaWidth < (uint16_t)count * referenceWidth)
+    {
+        mode = QDC_MODE_DELTA;
+        base = values[0];
+        residualWidth = deltaWidth;
+    }
+    else
+    {
+        mode = QDC_MODE_FRAME_OF_REFERENCE;
+        base = minimum;
+        residualWidth = referenceWidth;
+    }
+}
@@ -0,0 +1,27 @@
+/* Quest_DeltaEncoder.h Quest Delta Encoder Library
+ * Writes blocks of 16-bit samples to a Quest_BitWriter.
+ */
+#ifndef quest_deltaencoder_h
+#define quest_deltaencoder_h
+
+#include "Quest_DeltaCodec.h"
+#include "Quest_BitWriter.h"
+
+class Quest_DeltaEncoder
+{
+public:
+  Quest_DeltaEncoder(Quest_BitWriter *writer);
+
+  uint16_t blockBits(const int16_t *values, uint8_t count);
+  bool writeBlock(const int16_t *values, uint8_t count);
+
+private:
+  Quest_BitWriter *writer;
+  uint8_t mode;
+  int16_t base;
+  uint8_t residualWidth;
+
+  void chooseMode(const int16_t *values, uint8_t count);
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include "Quest_DoubleBufferedWriter.h"
+
+Quest_DoubleBufferedWriter::Quest_DoubleBufferedWriter(uint8_t *buffer0, uint8_t *buffer1, uint8_t bufferLength,
+                                                       Quest_TransmitCallback transmitCallback, void *context)
+    : writer0(buffer0, bufferLength), writer1(buffer1, bufferLength)
+{
+    this->buffers[0] = buffer0;
+    this->buffers[1] = buffer1;
+    this->writers[0] = &writer0;
+    this->writers[1] = &writer1;
+    this->bufferLength = bufferLength;
+    this->transmitCallback = transmitCallback;
+    this->backpressureCallback = NULL;
+    this->context = context;
+    this->activeIndex = 0;
+    setTransmitting(false);
+
+    reset();
+}
+
+void Quest_DoubleBufferedWriter::setBackpressureCallback(Quest_BackpressureCallback backpressureCallback)
+{
+    this->backpressureCallback = backpressureCallback;
+}
+
+void Quest_DoubleBufferedWriter::reset()
+{
+    // a transmission in progress is not cancelled, it still has to complete, so
+    // only the active buffer is reset (it is never the one being transmitted)
+    writers[activeIndex]->reset();
+    bitsTransmitted = 0;
+}
+
+uint32_t Quest_DoubleBufferedWriter::bitsWritten()
+{
+    return bitsTransmitted + writers[activeIndex]->bitsWritten();
+}
+
+bool Quest_DoubleBufferedWriter::isTransmitting()
+{
+#ifdef ARDUINO
+    return transmitting;
+#else
+    return transmitting.load(std::memory_order_acquire);
+#endif
+}
+
+bool Quest_DoubleBufferedWriter::writeBit(bool bit)
+{
+    return writeBits(bit, 1);
+}
+
+bool Quest_DoubleBufferedWriter::writeBits(uint32_t bits, uint8_t bitsToWrite)
+{
+    if (!hasRoomFor(bitsToWrite))
+    {
+        return false;
+    }
+
+    while (bitsToWrite > 0)
+    {
+        Quest_BitWriter *writer = writers[activeIndex];
+        if (writer->bitsRemaining() == 0)
+        {
+            // the full buffer could not be sent yet, wait for the other buffer
+            if (!transmitActiveBuffer())
+            {
+                return false;
+            }
+            continue;
+        }
+
+        // write the left-most bits that fit, the rest carry over to the next buffer
+        uint8_t bitsThatFit = min((uint16_t)bitsToWrite, writer->bitsRemaining());
+        bitsToWrite -= bitsThatFit;
+        writer->writeBits(bits >> bitsToWrite, bitsThatFit);
+
+        // start sending a full buffer right away when the other one is free
+        if (writer->bitsRemaining() == 0 && !isTransmitting())
+        {
+            transmitActiveBuffer();
+        }
+    }
+
+    return true;
+}
+
+bool Quest_DoubleBufferedWriter::writeBuffer(uint8_t *sourceBuffer, uint16_t bitsToWrite)
+{
+    // check up front so a failed write does not leave part of the buffer behind
+    if (!hasRoomFor(bitsToWrite))
+    {
+        return false;
+    }
+
+    uint16_t bytesToWrite = bitsToWrite >> 3;
+    for (uint16_t i = 0; i < bytesToWrite; i++)
+    {
+        if (!writeBits(sourceBuffer[i], 8))
+        {
+            return false;
+        }
+    }
+
+    // write any bits beyond the byte boundary from the left of the last byte
+    uint8_t bitsLeftToWrite = bitsToWrite & 0b111;
+    if (bitsLeftToWrite > 0)
+    {
+        return writeBits(sourceBuffer[bytesToWrite] >> (8 - bitsLeftToWrite), bitsLeftToWrite);
+    }
+
+    return true;
+}
+
+bool Quest_DoubleBufferedWriter::flush()
+{
+    if (writers[activeIndex]->bitsWritten() == 0)
+    {
+        return true;
+    }
+
+    return transmitActiveBuffer();
+}
+
+void Quest_DoubleBufferedWriter::transmitComplete()
+{
+    setTransmitting(false);
+}
+
+void Quest_DoubleBufferedWriter::setTransmitting(bool transmitting)
+{
+#ifdef ARDUINO
+    this->transmitting = transmitting;
+#else
+    this->transmitting.store(transmitting, std::memory_order_release);
+#endif
+}
+
+bool Quest_DoubleBufferedWriter::hasRoomFor(uint32_t bitsToWrite)
+{
+    // with backpressure, writes wait for space instead of failing
+    if (backpressureCallback != NULL)
+    {
+        return true;
+    }
+
+    // without it, the bits must fit in the active buffer plus the other buffer if it is free
+    uint32_t bitsFree = writers[activeIndex]->bitsRemaining();
+    if (!isTransmitting())
+    {
+        bitsFree += bufferLength * 8;
+    }
+    return bitsToWrite <= bitsFree;
+}
+
+bool Quest_DoubleBufferedWriter::waitForTransmit()
+{
+    while (isTransmitting())
+    {
+        if (backpressureCallback == NULL)
+        {
+            return false;
+        }
+        backpressureCallback(context);
+    }
+
+    return true;
+}
+
+bool Quest_DoubleBufferedWriter::transmitActiveBuffer()
+{
+    if (!waitForTransmit())
+    {
+        return false;
+    }
+
+    // mark the transmission first, the callback may complete it before returning
+    uint8_t transmitIndex = activeIndex;
+    uint16_t bitCount = writers[transmitIndex]->bitsWritten();
+    bitsTransmitted += bitCount;
+    activeIndex ^= 1;
+    writers[activeIndex]->reset();
+
+    setTransmitting(true);
+    transmitCallback(buffers[transmitIndex], bitCount, context);
+
+    return true;
+}
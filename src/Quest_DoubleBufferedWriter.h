@@ -0,0 +1,84 @@
+/* Quest_DoubleBufferedWriter.h Quest Double Buffered Writer Library
+ * Writes bits into one of two buffers while the other is transmitted.
+ *
+ * When the active buffer is full it is handed to the transmit callback (for
+ * example to start a DMA transfer) and writing continues in the other buffer.
+ * Buffers fill to a byte boundary, so the transmitted buffers join up into the
+ * same bit stream a single Quest_BitWriter would have written. flush() hands
+ * over a partially filled buffer.
+ *
+ * Completion and backpressure:
+ * Call transmitComplete() when a transmission finishes, usually from the DMA
+ * interrupt. Only one buffer is transmitted at a time. If both buffers are in
+ * use, writes call the backpressure callback until transmitComplete() is
+ * called. Without a backpressure callback, writeBits() and writeBuffer() are
+ * all or nothing: a write larger than the free space in the active buffer
+ * plus the free buffer fails without writing any bits, so streaming more than
+ * two buffers in one writeBuffer() call needs a backpressure callback.
+ * Buffers should be at least 4 bytes so a single writeBits() needs at most one
+ * swap.
+ *
+ * reset() does not touch a buffer that is still being transmitted, writing
+ * starts over in the free buffer.
+ *
+ * On the boards the transmitting flag is volatile, which is enough for a DMA
+ * interrupt on a single core. Host builds use an atomic flag with release and
+ * acquire ordering, so a completion thread's reads of a buffer finish before
+ * the writer reuses it.
+ */
+#ifndef quest_doublebufferedwriter_h
+#define quest_doublebufferedwriter_h
+
+#include "Quest_BitWriter.h"
+
+#ifndef ARDUINO
+#include <atomic>
+#endif
+
+typedef void (*Quest_TransmitCallback)(uint8_t *buffer, uint16_t bitCount, void *context);
+typedef void (*Quest_BackpressureCallback)(void *context);
+
+class Quest_DoubleBufferedWriter
+{
+public:
+  Quest_DoubleBufferedWriter(uint8_t *buffer0, uint8_t *buffer1, uint8_t bufferLength,
+                             Quest_TransmitCallback transmitCallback, void *context);
+
+  void setBackpressureCallback(Quest_BackpressureCallback backpressureCallback);
+
+  void reset();
+  uint32_t bitsWritten();
+  bool isTransmitting();
+
+  bool writeBit(bool bit);
+  bool writeBits(uint32_t bits, uint8_t bitsToWrite);
+  bool writeBuffer(uint8_t *sourceBuffer, uint16_t bitsToWrite);
+  bool flush();
+
+  void transmitComplete();
+
+private:
+  uint8_t *buffers[2];
+  Quest_BitWriter writer0;
+  Quest_BitWriter writer1;
+  Quest_BitWriter *writers[2];
+  uint8_t bufferLength;
+  uint8_t activeIndex;
+  uint32_t bitsTransmitted;
+#ifdef ARDUINO
+  volatile bool transmitting;
+#else
+  std::atomic<bool> transmitting;
+#endif
+
+  Quest_TransmitCallback transmitCallback;
+  Quest_BackpressureCallback backpressureCallback;
+  void *context;
+
+  void setTransmitting(bool transmitting);
+  bool hasRoomFor(uint32_t bitsToWrite);
+  bool waitForTransmit();
+  bool transmitActiveBuffer();
+};
+
+#endif
@@ -0,0 +1,161 @@
+#include "Quest_Hamming.h"
+
+// decoded entries hold the data nibble and whether the codeword had errors
+#define QHC_CORRECTED 0x10
+#define QHC_UNCORRECTABLE 0x20
+#define QHC_NIBBLE_MASK 0x0F
+
+// codewords for each nibble, with the overall parity as the last bit
+static const uint8_t encodeTable[16] = {
+    0x00, 0xD2, 0x55, 0x87, 0x99, 0x4B, 0xCC, 0x1E, 0xE1, 0x33, 0xB4, 0x66, 0x78, 0xAA, 0x2D, 0xFF};
+
+// Hamming(7,4) codeword to nibble, single bit errors are corrected
+static const uint8_t decodeTable74[128] = {
+    0x00, 0x10, 0x10, 0x13, 0x10, 0x15, 0x1E, 0x17, 0x10, 0x19, 0x12, 0x17, 0x14, 0x17, 0x17, 0x07,
+    0x10, 0x19, 0x1E, 0x1B, 0x1E, 0x1D, 0x0E, 0x1E, 0x19, 0x09, 0x1A, 0x19, 0x1C, 0x19, 0x1E, 0x17,
+    0x10, 0x15, 0x12, 0x1B, 0x15, 0x05, 0x16, 0x15, 0x12, 0x11, 0x02, 0x12, 0x1C, 0x15, 0x12, 0x17,
+    0x18, 0x1B, 0x1B, 0x0B, 0x1C, 0x15, 0x1E, 0x1B, 0x1C, 0x19, 0x12, 0x1B, 0x0C, 0x1C, 0x1C, 0x1F,
+    0x10, 0x13, 0x13, 0x03, 0x14, 0x1D, 0x16, 0x13, 0x14, 0x11, 0x1A, 0x13, 0x04, 0x14, 0x14, 0x17,
+    0x18, 0x1D, 0x1A, 0x13, 0x1D, 0x0D, 0x1E, 0x1D, 0x1A, 0x19, 0x0A, 0x1A, 0x14, 0x1D, 0x1A, 0x1F,
+    0x18, 0x11, 0x16, 0x13, 0x16, 0x15, 0x06, 0x16, 0x11, 0x01, 0x12, 0x11, 0x14, 0x11, 0x16, 0x1F,
+    0x08, 0x18, 0x18, 0x1B, 0x18, 0x1D, 0x16, 0x1F, 0x18, 0x11, 0x1A, 0x1F, 0x1C, 0x1F, 0x1F, 0x0F};
+
+// Hamming(8,4) codeword to nibble, double bit errors are detected but not corrected
+static const uint8_t decodeTable84[256] = {
+    0x00, 0x10, 0x10, 0x21, 0x10, 0x22, 0x23, 0x13, 0x10, 0x24, 0x25, 0x15, 0x26, 0x1E, 0x17, 0x27,
+    0x10, 0x20, 0x21, 0x19, 0x22, 0x12, 0x17, 0x23, 0x24, 0x14, 0x17, 0x25, 0x17, 0x26, 0x07, 0x17,
+    0x10, 0x28, 0x29, 0x19, 0x2A, 0x1E, 0x1B, 0x2B, 0x2C, 0x1E, 0x1D, 0x2D, 0x1E, 0x0E, 0x2F, 0x1E,
+    0x28, 0x19, 0x19, 0x09, 0x1A, 0x2A, 0x2B, 0x19, 0x1C, 0x2C, 0x2D, 0x19, 0x2E, 0x1E, 0x17, 0x2F,
+    0x10, 0x20, 0x21, 0x15, 0x22, 0x12, 0x1B, 0x23, 0x24, 0x15, 0x15, 0x05, 0x16, 0x26, 0x27, 0x15,
+    0x20, 0x12, 0x11, 0x21, 0x12, 0x02, 0x23, 0x12, 0x1C, 0x24, 0x25, 0x15, 0x26, 0x12, 0x17, 0x27,
+    0x28, 0x18, 0x1B, 0x29, 0x1B, 0x2A, 0x0B, 0x1B, 0x1C, 0x2C, 0x2D, 0x15, 0x2E, 0x1E, 0x1B, 0x2F,
+    0x1C, 0x28, 0x29, 0x19, 0x2A, 0x12, 0x1B, 0x2B, 0x0C, 0x1C, 0x1C, 0x2D, 0x1C, 0x2E, 0x2F, 0x1F,
+    0x10, 0x20, 0x21, 0x13, 0x22, 0x13, 0x13, 0x03, 0x24, 0x14, 0x1D, 0x25, 0x16, 0x26, 0x27, 0x13,
+    0x20, 0x14, 0x11, 0x21, 0x1A, 0x22, 0x23, 0x13, 0x14, 0x04, 0x25, 0x14, 0x26, 0x14, 0x17, 0x27,
+    0x28, 0x18, 0x1D, 0x29, 0x1A, 0x2A, 0x2B, 0x13, 0x1D, 0x2C, 0x0D, 0x1D, 0x2E, 0x1E, 0x1D, 0x2F,
+    0x1A, 0x28, 0x29, 0x19, 0x0A, 0x1A, 0x1A, 0x2B, 0x2C, 0x14, 0x1D, 0x2D, 0x1A, 0x2E, 0x2F, 0x1F,
+    0x20, 0x18, 0x11, 0x21, 0x16, 0x22, 0x23, 0x13, 0x16, 0x24, 0x25, 0x15, 0x06, 0x16, 0x16, 0x27,
+    0x11, 0x20, 0x01, 0x11, 0x22, 0x12, 0x11, 0x23, 0x24, 0x14, 0x11, 0x25, 0x16, 0x26, 0x27, 0x1F,
+    0x18, 0x08, 0x29, 0x18, 0x2A, 0x18, 0x1B, 0x2B, 0x2C, 0x18, 0x1D, 0x2D, 0x16, 0x2E, 0x2F, 0x1F,
+    0x28, 0x18, 0x11, 0x29, 0x1A, 0x2A, 0x2B, 0x1F, 0x1C, 0x2C, 0x2D, 0x1F, 0x2E, 0x1F, 0x1F, 0x0F};
+
+Quest_HammingEncoder::Quest_HammingEncoder(Quest_BitWriter *writer, bool extendedParity)
+{
+    this->writer = writer;
+    this->codewordBits = extendedParity ? QHC_EXTENDED_CODEWORD_BITS : QHC_CODEWORD_BITS;
+
+    reset();
+}
+
+void Quest_HammingEncoder::reset()
+{
+    nibble = 0;
+    nibbleBits = 0;
+}
+
+bool Quest_HammingEncoder::writeBit(bool bit)
+{
+    return writeBits(bit, 1);
+}
+
+bool Quest_HammingEncoder::writeBits(uint32_t bits, uint8_t bitsToWrite)
+{
+    // make sure there is enough room for every codeword this will complete
+    uint8_t codewordsToWrite = (nibbleBits + bitsToWrite) / QHC_DATA_BITS;
+    if (codewordsToWrite * codewordBits > writer->bitsRemaining())
+    {
+        return false;
+    }
+
+    for (uint8_t i = bitsToWrite; i > 0; i--)
+    {
+        nibble = (nibble << 1) | ((bits >> (i - 1)) & 1);
+        nibbleBits++;
+        if (nibbleBits == QHC_DATA_BITS)
+        {
+            // the 7 bit codeword drops the overall parity bit
+            writer->writeBits(encodeTable[nibble] >> (QHC_EXTENDED_CODEWORD_BITS - codewordBits), codewordBits);
+            nibble = 0;
+            nibbleBits = 0;
+        }
+    }
+
+    return true;
+}
+
+bool Quest_HammingEncoder::flush()
+{
+    if (nibbleBits == 0)
+    {
+        return true;
+    }
+
+    // pad the partial nibble with 0's
+    return writeBits(0, QHC_DATA_BITS - nibbleBits);
+}
+
+Quest_HammingDecoder::Quest_HammingDecoder(Quest_BitReader *reader, bool extendedParity)
+{
+    this->reader = reader;
+    this->codewordBits = extendedParity ? QHC_EXTENDED_CODEWORD_BITS : QHC_CODEWORD_BITS;
+
+    reset();
+}
+
+void Quest_HammingDecoder::reset()
+{
+    correctedErrors = 0;
+    uncorrectableErrors = 0;
+    nibble = 0;
+    nibbleBits = 0;
+}
+
+bool Quest_HammingDecoder::readBit()
+{
+    return readBits(1);
+}
+
+uint32_t Quest_HammingDecoder::readBits(uint8_t bitsToRead)
+{
+    uint32_t readBits = 0;
+    for (uint8_t i = 0; i < bitsToRead; i++)
+    {
+        if (nibbleBits == 0)
+        {
+            readNibble();
+        }
+
+        // take the next bit from the left of the decoded nibble
+        nibbleBits--;
+        readBits = (readBits << 1) | ((nibble >> nibbleBits) & 1);
+    }
+
+    return readBits;
+}
+
+void Quest_HammingDecoder::readNibble()
+{
+    // codewords read past the available bits decode to 0's
+    uint8_t codeword = reader->readBits(codewordBits);
+    uint8_t decoded;
+    if (codewordBits == QHC_EXTENDED_CODEWORD_BITS)
+    {
+        decoded = decodeTable84[codeword];
+    }
+    else
+    {
+        decoded = decodeTable74[codeword];
+    }
+
+    if (decoded & QHC_CORRECTED)
+    {
+        correctedErrors++;
+    }
+    if (decoded & QHC_UNCORRECTABLE)
+    {
+        uncorrectableErrors++;
+    }
+
+    nibble = decoded & QHC_NIBBLE_MASK;
+    nibbleBits = QHC_DATA_BITS;
+}
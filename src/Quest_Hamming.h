@@ -0,0 +1,62 @@
+/* Quest_Hamming.h Quest Hamming Code Library
+ * Forward error correction with Hamming codes over the bit buffer classes.
+ *
+ * Format:
+ * Every 4 data bits become a Hamming(7,4) codeword, which corrects any single
+ * bit error. With extended parity, an overall parity bit makes a Hamming(8,4)
+ * SECDED codeword, which also detects double bit errors. Call flush() after the
+ * last bit so a partial nibble is padded with 0's and written.
+ *
+ * Burst errors should be spread across codewords with Quest_Interleaver.h.
+ */
+#ifndef quest_hamming_h
+#define quest_hamming_h
+
+#include "Quest_BitWriter.h"
+#include "Quest_BitReader.h"
+
+#define QHC_DATA_BITS 4
+#define QHC_CODEWORD_BITS 7
+#define QHC_EXTENDED_CODEWORD_BITS 8
+
+class Quest_HammingEncoder
+{
+public:
+  Quest_HammingEncoder(Quest_BitWriter *writer, bool extendedParity);
+
+  void reset();
+
+  bool writeBit(bool bit);
+  bool writeBits(uint32_t bits, uint8_t bitsToWrite);
+  bool flush();
+
+private:
+  Quest_BitWriter *writer;
+  uint8_t codewordBits;
+  uint8_t nibble;
+  uint8_t nibbleBits;
+};
+
+class Quest_HammingDecoder
+{
+public:
+  Quest_HammingDecoder(Quest_BitReader *reader, bool extendedParity);
+
+  uint16_t correctedErrors;
+  uint16_t uncorrectableErrors;
+
+  void reset();
+
+  bool readBit();
+  uint32_t readBits(uint8_t bitsToRead);
+
+private:
+  Quest_BitReader *reader;
+  uint8_t codewordBits;
+  uint8_t nibble;
+  uint8_t nibbleBits;
+
+  void readNibble();
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "Quest_Interleaver.h"
+
+static bool canCopy(Quest_BitReader *source, Quest_BitWriter *destination, uint16_t bitsToCopy, uint8_t depth)
+{
+    return depth > 0 && bitsToCopy <= source->bitsRemaining() && bitsToCopy <= destination->bitsRemaining();
+}
+
+bool interleaveBits(Quest_BitReader *source, Quest_BitWriter *destination, uint16_t bitsToCopy, uint8_t depth)
+{
+    if (!canCopy(source, destination, bitsToCopy, depth))
+    {
+        return false;
+    }
+
+    uint16_t start = source->bitPosition;
+    for (uint8_t column = 0; column < depth; column++)
+    {
+        for (uint16_t i = column; i < bitsToCopy; i += depth)
+        {
+            source->seek(start + i);
+            destination->writeBit(source->readBit());
+        }
+    }
+
+    source->seek(start + bitsToCopy);
+    return true;
+}
+
+bool deinterleaveBits(Quest_BitReader *source, Quest_BitWriter *destination, uint16_t bitsToCopy, uint8_t depth)
+{
+    if (!canCopy(source, destination, bitsToCopy, depth))
+    {
+        return false;
+    }
+
+    // the first (bitsToCopy % depth) columns have one more bit than the rest
+    uint16_t rows = bitsToCopy / depth;
+    uint8_t longColumns = bitsToCopy % depth;
+
+    uint16_t start = source->bitPosition;
+    for (uint16_t i = 0; i < bitsToCopy; i++)
+    {
+        uint8_t column = i % depth;
+        uint16_t columnStart = column * rows + min(column, longColumns);
+        source->seek(start + columnStart + i / depth);
+        destination->writeBit(source->readBit());
+    }
+
+    source->seek(start + bitsToCopy);
+    return true;
+}
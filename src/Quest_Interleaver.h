@@ -0,0 +1,23 @@
+/* Quest_Interleaver.h Quest Bit Interleaver Library
+ * Spreads burst errors across codewords with a block interleaver.
+ *
+ * Format:
+ * Bits are interleaved by depth: the output is every depth-th bit starting at
+ * bit 0, then every depth-th bit starting at bit 1, and so on. Adjacent bits
+ * on the link are depth bits apart in the original order, so a burst of errors
+ * lands in different codewords when depth is at least the codeword length.
+ *
+ * Both functions read the source from its current position and move it past
+ * the bits copied. They return false without copying if the source does not
+ * have enough bits or the destination does not have enough room.
+ */
+#ifndef quest_interleaver_h
+#define quest_interleaver_h
+
+#include "Quest_BitWriter.h"
+#include "Quest_BitReader.h"
+
+bool interleaveBits(Quest_BitReader *source, Quest_BitWriter *destination, uint16_t bitsToCopy, uint8_t depth);
+bool deinterleaveBits(Quest_BitReader *source, Quest_BitWriter *destination, uint16_t bitsToCopy, uint8_t depth);
+
+#endif
@@ -0,0 +1,326 @@
+#if defined(__linux__)
+
+#include "Quest_MappedBitReader.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define QMBR_INDEX_MAGIC 0x49424251 // "QBBI"
+#define QMBR_INDEX_VERSION 1
+
+struct Quest_FrameIndexHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t captureLength;
+    uint64_t frameCount;
+};
+
+Quest_MappedBitReader::Quest_MappedBitReader()
+{
+    buffer = NULL;
+    bufferLength = 0;
+    bitCount = 0;
+    bitPosition = 0;
+}
+
+Quest_MappedBitReader::~Quest_MappedBitReader()
+{
+    close();
+}
+
+bool Quest_MappedBitReader::open(const char *path)
+{
+    close();
+
+    int file = ::open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    // an empty capture cannot be mapped, but is still a valid capture
+    if (fileStat.st_size > 0)
+    {
+        void *mapped = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapped == MAP_FAILED)
+        {
+            ::close(file);
+            return false;
+        }
+
+        // captures are mostly decoded front to back, ask the kernel to read ahead
+        madvise(mapped, fileStat.st_size, MADV_SEQUENTIAL);
+        madvise(mapped, fileStat.st_size, MADV_WILLNEED);
+
+        buffer = (const uint8_t *)mapped;
+        bufferLength = fileStat.st_size;
+    }
+
+    // the mapping stays valid after the file is closed
+    ::close(file);
+
+    this->path = path;
+    reset(bufferLength * 8);
+
+    return true;
+}
+
+void Quest_MappedBitReader::close()
+{
+    if (buffer != NULL)
+    {
+        munmap((void *)buffer, bufferLength);
+    }
+
+    buffer = NULL;
+    bufferLength = 0;
+    path.clear();
+    frameIndex.clear();
+    reset(0);
+}
+
+bool Quest_MappedBitReader::reset(uint64_t bitsAvailable)
+{
+    // bits available should never exceed the capture size
+    bitCount = bitsAvailable < bufferLength * 8 ? bitsAvailable : bufferLength * 8;
+    bitPosition = 0;
+
+    return bitCount == bitsAvailable;
+}
+
+uint64_t Quest_MappedBitReader::bitsRemaining()
+{
+    return bitCount - bitPosition;
+}
+
+bool Quest_MappedBitReader::seek(uint64_t position)
+{
+    // position should never exceed the bits available
+    bitPosition = position < bitCount ? position : bitCount;
+
+    return bitPosition == position;
+}
+
+bool Quest_MappedBitReader::readBit()
+{
+    if (bitPosition >= bitCount)
+    {
+        // already read all available bits
+        return 0;
+    }
+
+    bool bit = (buffer[bitPosition >> 3] >> (7 - (bitPosition & 0b111))) & 1;
+    bitPosition++;
+
+    return bit;
+}
+
+uint32_t Quest_MappedBitReader::readBits(uint8_t bitsToRead)
+{
+    if (bitPosition >= bitCount)
+    {
+        // already read all available bits
+        return 0;
+    }
+
+    // do not read more bits than available
+    if (bitsToRead > bitsRemaining())
+    {
+        bitsToRead = bitsRemaining();
+    }
+    if (bitsToRead == 0)
+    {
+        return 0;
+    }
+
+    // like Quest_BitReader, a wider read keeps only its last 32 bits
+    if (bitsToRead > 32)
+    {
+        bitPosition += bitsToRead - 32;
+        bitsToRead = 32;
+    }
+
+    // load the (up to) 5 bytes holding the bits, without reading past the mapping
+    uint64_t bytePosition = bitPosition >> 3;
+    uint8_t bitOffset = bitPosition & 0b111;
+    uint8_t bytesToLoad = (bitOffset + bitsToRead + 7) >> 3;
+    uint64_t word = 0;
+    for (uint8_t i = 0; i < bytesToLoad; i++)
+    {
+        word = (word << 8) | buffer[bytePosition + i];
+    }
+
+    // drop the bits after the read, then the bits before it
+    word >>= (bytesToLoad << 3) - bitOffset - bitsToRead;
+    bitPosition += bitsToRead;
+
+    return word & (0xFFFFFFFF >> (32 - bitsToRead));
+}
+
+uint64_t Quest_MappedBitReader::readBuffer(uint8_t *destinationBuffer, uint64_t bitsToRead)
+{
+    if (bitPosition >= bitCount)
+    {
+        // already read all available bits
+        return 0;
+    }
+
+    // do not read more bits than available
+    if (bitsToRead > bitsRemaining())
+    {
+        bitsToRead = bitsRemaining();
+    }
+
+    uint64_t bytesToRead = bitsToRead >> 3;
+    uint8_t bitsLeftToRead = bitsToRead & 0b111;
+    if ((bitPosition & 0b111) == 0)
+    {
+        // byte-aligned reads are a straight copy out of the mapping
+        memcpy(destinationBuffer, &buffer[bitPosition >> 3], bytesToRead);
+        bitPosition += bytesToRead << 3;
+    }
+    else
+    {
+        for (uint64_t i = 0; i < bytesToRead; i++)
+        {
+            destinationBuffer[i] = readBits(8);
+        }
+    }
+
+    // make sure any bits beyond the byte boundary are stored left-aligned
+    if (bitsLeftToRead > 0)
+    {
+        destinationBuffer[bytesToRead] = readBits(bitsLeftToRead) << (8 - bitsLeftToRead);
+    }
+
+    return bitsToRead;
+}
+
+uint32_t Quest_MappedBitReader::buildFrameIndex(Quest_FrameReader frameReader, void *context)
+{
+    frameIndex.clear();
+
+    // every frame starts where the previous one ended
+    seek(0);
+    while (bitPosition < bitCount)
+    {
+        uint64_t frameStart = bitPosition;
+        if (!frameReader(this, context) || bitPosition <= frameStart)
+        {
+            break;
+        }
+        frameIndex.push_back(frameStart);
+    }
+
+    seek(0);
+    return frameIndex.size();
+}
+
+bool Quest_MappedBitReader::saveFrameIndex()
+{
+    FILE *file = fopen(frameIndexPath().c_str(), "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    Quest_FrameIndexHeader header;
+    header.magic = QMBR_INDEX_MAGIC;
+    header.version = QMBR_INDEX_VERSION;
+    header.captureLength = bufferLength;
+    header.frameCount = frameIndex.size();
+
+    bool saved = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 fwrite(frameIndex.data(), sizeof(uint64_t), frameIndex.size(), file) == frameIndex.size();
+
+    return fclose(file) == 0 && saved;
+}
+
+bool Quest_MappedBitReader::loadFrameIndex()
+{
+    FILE *file = fopen(frameIndexPath().c_str(), "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fileno(file), &fileStat) != 0 || (uint64_t)fileStat.st_size < sizeof(Quest_FrameIndexHeader))
+    {
+        fclose(file);
+        return false;
+    }
+    uint64_t framesInFile = (fileStat.st_size - sizeof(Quest_FrameIndexHeader)) / sizeof(uint64_t);
+
+    // an index saved for a different capture size is stale, and the frame count
+    // must match the file before it is trusted with an allocation
+    Quest_FrameIndexHeader header;
+    bool loaded = fread(&header, sizeof(header), 1, file) == 1 &&
+                  header.magic == QMBR_INDEX_MAGIC &&
+                  header.version == QMBR_INDEX_VERSION &&
+                  header.captureLength == bufferLength &&
+                  header.frameCount == framesInFile &&
+                  header.frameCount <= header.captureLength * 8;
+    if (loaded)
+    {
+        frameIndex.resize(header.frameCount);
+        loaded = fread(frameIndex.data(), sizeof(uint64_t), frameIndex.size(), file) == frameIndex.size();
+    }
+    fclose(file);
+
+    // frames must start inside the capture, in order
+    for (size_t i = 0; loaded && i < frameIndex.size(); i++)
+    {
+        loaded = frameIndex[i] < bitCount && (i == 0 || frameIndex[i] > frameIndex[i - 1]);
+    }
+
+    if (!loaded)
+    {
+        frameIndex.clear();
+    }
+    return loaded;
+}
+
+uint32_t Quest_MappedBitReader::frameCount()
+{
+    return frameIndex.size();
+}
+
+uint64_t Quest_MappedBitReader::frameBitPosition(uint32_t frame)
+{
+    if (frame >= frameIndex.size())
+    {
+        return bitCount;
+    }
+
+    return frameIndex[frame];
+}
+
+bool Quest_MappedBitReader::seekToFrame(uint32_t frame)
+{
+    if (frame >= frameIndex.size())
+    {
+        return false;
+    }
+
+    return seek(frameIndex[frame]);
+}
+
+std::string Quest_MappedBitReader::frameIndexPath()
+{
+    return path + ".idx";
+}
+
+#endif
@@ -0,0 +1,73 @@
+/* Quest_MappedBitReader.h Quest Mapped Bit Reader Library
+ * Reads bits from a memory-mapped capture file, for host-side replay tools.
+ *
+ * Linux only, the class is not built for the Arduino targets.
+ *
+ * The reader has the same reading API as Quest_BitReader with 64-bit
+ * positions, so a capture of concatenated packets can be decoded in place
+ * without copying it into buffer-sized windows. As with Quest_BitReader,
+ * readBits() wider than 32 bits returns the last 32 bits and advances past
+ * all of them.
+ *
+ * Frame index:
+ * buildFrameIndex() walks the capture once, calling a frame reader that reads
+ * (or seeks) past one frame and returns false at the end of the capture. The
+ * bit offset of each frame is saved next to the capture as "<capture>.idx" so
+ * later runs can load it and seek straight to a frame.
+ */
+#ifndef quest_mappedbitreader_h
+#define quest_mappedbitreader_h
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class Quest_MappedBitReader;
+
+typedef bool (*Quest_FrameReader)(Quest_MappedBitReader *reader, void *context);
+
+class Quest_MappedBitReader
+{
+public:
+  Quest_MappedBitReader();
+  ~Quest_MappedBitReader();
+
+  uint64_t bitCount;
+  uint64_t bitPosition;
+
+  bool open(const char *path);
+  void close();
+
+  bool reset(uint64_t bitsAvailable);
+  uint64_t bitsRemaining();
+  bool seek(uint64_t position);
+
+  bool readBit();
+  uint32_t readBits(uint8_t bitsToRead);
+  uint64_t readBuffer(uint8_t *destinationBuffer, uint64_t bitsToRead);
+
+  uint32_t buildFrameIndex(Quest_FrameReader frameReader, void *context);
+  bool saveFrameIndex();
+  bool loadFrameIndex();
+  uint32_t frameCount();
+  uint64_t frameBitPosition(uint32_t frame);
+  bool seekToFrame(uint32_t frame);
+
+private:
+  std::string path;
+  const uint8_t *buffer;
+  uint64_t bufferLength;
+  std::vector<uint64_t> frameIndex;
+
+  std::string frameIndexPath();
+
+  // the reader owns its mapping, so it cannot be copied
+  Quest_MappedBitReader(const Quest_MappedBitReader &);
+  Quest_MappedBitReader &operator=(const Quest_MappedBitReader &);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+#include "Quest_MultiLaneBitReader.h"
+
+Quest_MultiLaneBitReader::Quest_MultiLaneBitReader()
+{
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        setLane(lane, NULL, 0);
+    }
+}
+
+void Quest_MultiLaneBitReader::setLane(uint8_t lane, uint8_t *buffer, uint8_t bufferLength)
+{
+    buffers[lane] = buffer;
+    bufferLengths[lane] = bufferLength;
+
+    reset(lane, bufferLength * 8);
+}
+
+bool Quest_MultiLaneBitReader::reset(uint8_t lane, uint16_t bitsAvailable)
+{
+    // bits available should never exceed buffer size
+    bitCount[lane] = min(bitsAvailable, bufferLengths[lane] * 8);
+    bitPosition[lane] = 0;
+
+    return bitCount[lane] == bitsAvailable;
+}
+
+uint16_t Quest_MultiLaneBitReader::bitsRemaining(uint8_t lane)
+{
+    return bitCount[lane] - bitPosition[lane];
+}
+
+void Quest_MultiLaneBitReader::readBit(bool *bits)
+{
+    uint32_t values[QBB_LANES];
+    readBits(1, values);
+
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        bits[lane] = values[lane];
+    }
+}
+
+void Quest_MultiLaneBitReader::readBits(uint8_t bitsToRead, uint32_t *values)
+{
+    // a value holds at most 32 bits, and the window shift below relies on it
+    if (bitsToRead > 32)
+    {
+        bitsToRead = 32;
+    }
+
+    // every lane does the same steps on its own cursor, with no dependency between lanes
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        // do not read more bits than available
+        uint8_t laneBitsToRead = min((uint16_t)bitsToRead, bitsRemaining(lane));
+        if (laneBitsToRead == 0)
+        {
+            values[lane] = 0;
+            continue;
+        }
+
+        // load the 5 bytes that can hold a 32 bit field, without reading past the buffer
+        uint16_t position = bitPosition[lane];
+        uint8_t bytePosition = position >> 3;
+        uint8_t bytesInWindow = min(5, bufferLengths[lane] - bytePosition);
+        uint64_t window = 0;
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            window <<= 8;
+            if (i < bytesInWindow)
+            {
+                window |= buffers[lane][bytePosition + i];
+            }
+        }
+
+        // drop the bits after the field, then mask off the bits before it
+        uint8_t bitOffset = position & 0b111;
+        window >>= 40 - bitOffset - laneBitsToRead;
+        values[lane] = window & (0xFFFFFFFF >> (32 - laneBitsToRead));
+
+        bitPosition[lane] = position + laneBitsToRead;
+    }
+}
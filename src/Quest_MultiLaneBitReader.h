@@ -0,0 +1,42 @@
+/* Quest_MultiLaneBitReader.h Quest Multi-Lane Bit Reader Library
+ * Reads the same fields from several independent byte buffers in lockstep.
+ *
+ * Each lane behaves like its own Quest_BitReader. readBits() reads the same
+ * number of bits from every lane into one value per lane, so decoding several
+ * short messages with the same layout runs as independent work per lane
+ * instead of one long chain of dependent shifts. Lanes that run out of bits
+ * read 0's, and lanes without a buffer always read 0's. A single readBits()
+ * reads at most 32 bits per lane, wider reads are clamped to 32.
+ *
+ * The number of lanes is set at build time with QBB_LANES.
+ */
+#ifndef quest_multilanebitreader_h
+#define quest_multilanebitreader_h
+
+#include "Quest_BitBuffer.h"
+
+#ifndef QBB_LANES
+#define QBB_LANES 4
+#endif
+
+class Quest_MultiLaneBitReader
+{
+public:
+  Quest_MultiLaneBitReader();
+
+  uint16_t bitCount[QBB_LANES];
+  uint16_t bitPosition[QBB_LANES];
+
+  void setLane(uint8_t lane, uint8_t *buffer, uint8_t bufferLength);
+  bool reset(uint8_t lane, uint16_t bitsAvailable);
+  uint16_t bitsRemaining(uint8_t lane);
+
+  void readBit(bool *bits);
+  void readBits(uint8_t bitsToRead, uint32_t *values);
+
+private:
+  uint8_t *buffers[QBB_LANES];
+  uint8_t bufferLengths[QBB_LANES];
+};
+
+#endif
@@ -0,0 +1,9 @@
+#include "Quest_RangeCoder.h"
+
+void resetProbabilities(uint16_t *probabilities, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        probabilities[i] = QRC_PROBABILITY_INIT;
+    }
+}
@@ -0,0 +1,30 @@
+/* Quest_RangeCoder.h Quest Range Coder Library
+ * Adaptive binary range coding (LZMA style) on top of the bit buffer classes.
+ *
+ * See Quest_RangeEncoder.h to encode bits and Quest_RangeDecoder.h to
+ * decode bits.
+ *
+ * Probability models:
+ * Each context is a single uint16_t holding the probability that the next bit
+ * is a 0, out of QRC_PROBABILITY_MAX. Contexts adapt as bits are coded, so
+ * the encoder and decoder must start with the same reset contexts and use them
+ * in the same order. A bit tree of N bits uses (1 << N) contexts.
+ *
+ * Format:
+ * Bytes are written and read 8 bits at a time through Quest_BitWriter and
+ * Quest_BitReader, so a range coded section can follow other bit fields.
+ */
+#ifndef quest_rangecoder_h
+#define quest_rangecoder_h
+
+#include "Quest_BitBuffer.h"
+
+#define QRC_PROBABILITY_BITS 11
+#define QRC_PROBABILITY_MAX (1 << QRC_PROBABILITY_BITS)
+#define QRC_PROBABILITY_INIT (QRC_PROBABILITY_MAX >> 1)
+#define QRC_MOVE_BITS 5
+#define QRC_TOP_VALUE 0x01000000
+
+void resetProbabilities(uint16_t *probabilities, uint16_t count);
+
+#endif
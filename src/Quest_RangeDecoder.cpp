@@ -0,0 +1,82 @@
+#include "Quest_RangeDecoder.h"
+
+Quest_RangeDecoder::Quest_RangeDecoder(Quest_BitReader *reader)
+{
+    this->reader = reader;
+    this->range = 0xFFFFFFFF;
+    this->code = 0;
+}
+
+bool Quest_RangeDecoder::reset()
+{
+    // the encoder never writes its first byte, so only 4 bytes start the code
+    bool enoughBits = reader->bitsRemaining() >= 32;
+
+    range = 0xFFFFFFFF;
+    code = reader->readBits(32);
+
+    return enoughBits;
+}
+
+bool Quest_RangeDecoder::decodeBit(uint16_t *probability)
+{
+    uint32_t bound = (range >> QRC_PROBABILITY_BITS) * *probability;
+    bool bit;
+    if (code < bound)
+    {
+        range = bound;
+        *probability += (QRC_PROBABILITY_MAX - *probability) >> QRC_MOVE_BITS;
+        bit = false;
+    }
+    else
+    {
+        code -= bound;
+        range -= bound;
+        *probability -= *probability >> QRC_MOVE_BITS;
+        bit = true;
+    }
+
+    normalize();
+
+    return bit;
+}
+
+uint32_t Quest_RangeDecoder::decodeBitTree(uint16_t *probabilities, uint8_t bitsToDecode)
+{
+    // the context ends with a leading 1 followed by the decoded bits
+    uint32_t context = 1;
+    for (uint8_t i = 0; i < bitsToDecode; i++)
+    {
+        context = (context << 1) | decodeBit(&probabilities[context]);
+    }
+
+    return context - ((uint32_t)1 << bitsToDecode);
+}
+
+uint32_t Quest_RangeDecoder::decodeDirectBits(uint8_t bitsToDecode)
+{
+    uint32_t bits = 0;
+    for (uint8_t i = 0; i < bitsToDecode; i++)
+    {
+        range >>= 1;
+        bits <<= 1;
+        if (code >= range)
+        {
+            code -= range;
+            bits |= 1;
+        }
+        normalize();
+    }
+
+    return bits;
+}
+
+void Quest_RangeDecoder::normalize()
+{
+    // bits read past the end of the reader are 0's
+    while (range < QRC_TOP_VALUE)
+    {
+        range <<= 8;
+        code = (code << 8) | reader->readBits(8);
+    }
+}
@@ -0,0 +1,33 @@
+/* Quest_RangeDecoder.h Quest Range Decoder Library
+ * Decodes bits with adaptive probabilities from a Quest_BitReader.
+ *
+ * Constructing the decoder does not read anything. Call reset() once the
+ * reader is positioned at the start of the encoded bits, it reads the first
+ * 4 bytes and returns false if they are not available.
+ */
+#ifndef quest_rangedecoder_h
+#define quest_rangedecoder_h
+
+#include "Quest_RangeCoder.h"
+#include "Quest_BitReader.h"
+
+class Quest_RangeDecoder
+{
+public:
+  Quest_RangeDecoder(Quest_BitReader *reader);
+
+  bool reset();
+
+  bool decodeBit(uint16_t *probability);
+  uint32_t decodeBitTree(uint16_t *probabilities, uint8_t bitsToDecode);
+  uint32_t decodeDirectBits(uint8_t bitsToDecode);
+
+private:
+  Quest_BitReader *reader;
+  uint32_t range;
+  uint32_t code;
+
+  void normalize();
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "Quest_RangeEncoder.h"
+
+Quest_RangeEncoder::Quest_RangeEncoder(Quest_BitWriter *writer)
+{
+    this->writer = writer;
+
+    reset();
+}
+
+void Quest_RangeEncoder::reset()
+{
+    low = 0;
+    range = 0xFFFFFFFF;
+    cache = 0;
+    cacheSize = 0;
+}
+
+bool Quest_RangeEncoder::encodeBit(uint16_t *probability, bool bit)
+{
+    uint32_t bound = (range >> QRC_PROBABILITY_BITS) * *probability;
+    if (bit)
+    {
+        low += bound;
+        range -= bound;
+        *probability -= *probability >> QRC_MOVE_BITS;
+    }
+    else
+    {
+        range = bound;
+        *probability += (QRC_PROBABILITY_MAX - *probability) >> QRC_MOVE_BITS;
+    }
+
+    return normalize();
+}
+
+bool Quest_RangeEncoder::encodeBitTree(uint16_t *probabilities, uint8_t bitsToEncode, uint32_t bits)
+{
+    // each bit is coded with a context chosen by the bits before it
+    uint32_t context = 1;
+    for (uint8_t i = bitsToEncode; i > 0; i--)
+    {
+        bool bit = (bits >> (i - 1)) & 1;
+        if (!encodeBit(&probabilities[context], bit))
+        {
+            return false;
+        }
+        context = (context << 1) | bit;
+    }
+
+    return true;
+}
+
+bool Quest_RangeEncoder::encodeDirectBits(uint32_t bits, uint8_t bitsToEncode)
+{
+    // direct bits have a fixed 50% probability and use no context
+    for (uint8_t i = bitsToEncode; i > 0; i--)
+    {
+        range >>= 1;
+        if ((bits >> (i - 1)) & 1)
+        {
+            low += range;
+        }
+        if (!normalize())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Quest_RangeEncoder::flush()
+{
+    // push the pending bytes and all of low out to the writer
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        if (!shiftLow())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Quest_RangeEncoder::normalize()
+{
+    // renormalize a byte at a time once the top byte of the range is empty
+    while (range < QRC_TOP_VALUE)
+    {
+        range <<= 8;
+        if (!shiftLow())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Quest_RangeEncoder::shiftLow()
+{
+    uint32_t lowBits = (uint32_t)low;
+    uint8_t carry = low >> 32;
+
+    // a 0xFF top byte may still change from a carry, so it stays pending with the cache
+    if (cacheSize == 0 || lowBits < 0xFF000000 || carry != 0)
+    {
+        // the first pending byte is always 0 and never carried into, so it is never written
+        if (cacheSize > 0)
+        {
+            if (!writer->writeBits((uint8_t)(cache + carry), 8))
+            {
+                return false;
+            }
+            while (--cacheSize > 0)
+            {
+                if (!writer->writeBits((uint8_t)(0xFF + carry), 8))
+                {
+                    return false;
+                }
+            }
+        }
+        cache = lowBits >> 24;
+    }
+    cacheSize++;
+    low = lowBits << 8;
+
+    return true;
+}
@@ -0,0 +1,36 @@
+/* Quest_RangeEncoder.h Quest Range Encoder Library
+ * Encodes bits with adaptive probabilities to a Quest_BitWriter.
+ *
+ * Call flush() after the last bit to write the remaining bytes. If a write
+ * returns false the writer is full and the encoded bits are incomplete.
+ */
+#ifndef quest_rangeencoder_h
+#define quest_rangeencoder_h
+
+#include "Quest_RangeCoder.h"
+#include "Quest_BitWriter.h"
+
+class Quest_RangeEncoder
+{
+public:
+  Quest_RangeEncoder(Quest_BitWriter *writer);
+
+  void reset();
+
+  bool encodeBit(uint16_t *probability, bool bit);
+  bool encodeBitTree(uint16_t *probabilities, uint8_t bitsToEncode, uint32_t bits);
+  bool encodeDirectBits(uint32_t bits, uint8_t bitsToEncode);
+  bool flush();
+
+private:
+  Quest_BitWriter *writer;
+  uint64_t low;
+  uint32_t range;
+  uint8_t cache;
+  uint16_t cacheSize;
+
+  bool normalize();
+  bool shiftLow();
+};
+
+#endif
@@ -234,6 +234,193 @@ void test_zero_returned_for_bits_read_past_available()
     TEST_ASSERT_EQUAL(0, br.readBuffer(readBuffer, 10 * 8));
 }
 
+void test_seek_moves_read_position()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    buffer[0] = 0b00000000;
+    buffer[1] = 0b00101100;
+    br.reset(16);
+
+    TEST_ASSERT_TRUE(br.seek(10));
+    TEST_ASSERT_EQUAL(10, br.bitPosition);
+    TEST_ASSERT_EQUAL(6, br.bitsRemaining());
+    TEST_ASSERT_EQUAL(0b1011, br.readBits(4));
+
+    TEST_ASSERT_TRUE(br.seek(2));
+    TEST_ASSERT_EQUAL(0, br.readBits(8));
+
+    // seeking past the available bits stops at the end
+    TEST_ASSERT_FALSE(br.seek(20));
+    TEST_ASSERT_EQUAL(16, br.bitPosition);
+    TEST_ASSERT_EQUAL(0, br.bitsRemaining());
+}
+
+void test_peek_word_stops_at_available_bits()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    buffer[0] = 0b10110011;
+    buffer[1] = 0b11110000;
+    buffer[2] = 0b11111111;
+    br.reset(12);
+
+    uint8_t bitsInWord;
+    TEST_ASSERT_EQUAL_HEX32(0xB3F00000, br.peekWord(0, &bitsInWord));
+    TEST_ASSERT_EQUAL(12, bitsInWord);
+    TEST_ASSERT_EQUAL_HEX32(0xCFC00000, br.peekWord(2, &bitsInWord));
+    TEST_ASSERT_EQUAL(10, bitsInWord);
+
+    // at or past the end the word is empty
+    TEST_ASSERT_EQUAL_HEX32(0, br.peekWord(12, &bitsInWord));
+    TEST_ASSERT_EQUAL(0, bitsInWord);
+    TEST_ASSERT_EQUAL_HEX32(0, br.peekWord(20, &bitsInWord));
+    TEST_ASSERT_EQUAL(0, bitsInWord);
+    TEST_ASSERT_EQUAL(0, br.bitPosition);
+}
+
+void test_count_leading_zeros_and_ones()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    memset(buffer, 0, BUFFER_SIZE);
+    buffer[5] = 0b00011111;
+    buffer[6] = 0b11111111;
+    buffer[7] = 0b11111110;
+    br.reset(BUFFER_SIZE_IN_BITS);
+
+    // unary-style decode, count then skip past the terminating bit
+    br.readBits(3);
+    TEST_ASSERT_EQUAL(40, br.countLeadingZeros());
+    TEST_ASSERT_EQUAL(3, br.bitPosition);
+    TEST_ASSERT_EQUAL(0, br.countLeadingOnes());
+
+    br.seek(43);
+    TEST_ASSERT_EQUAL(0, br.countLeadingZeros());
+    TEST_ASSERT_EQUAL(20, br.countLeadingOnes());
+
+    // scans stop at the bits available
+    br.reset(50);
+    br.seek(43);
+    TEST_ASSERT_EQUAL(7, br.countLeadingOnes());
+    br.reset(30);
+    TEST_ASSERT_EQUAL(30, br.countLeadingZeros());
+}
+
+void test_find_next_set_and_clear_bits()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    memset(buffer, 0xFF, BUFFER_SIZE);
+    buffer[20] = 0b11110111;
+    buffer[40] = 0b00000000;
+    buffer[41] = 0b01000000;
+    br.reset(BUFFER_SIZE_IN_BITS);
+
+    TEST_ASSERT_EQUAL(0, br.findNextSetBit(0));
+    TEST_ASSERT_EQUAL(164, br.findNextClearBit(0));
+    TEST_ASSERT_EQUAL(164, br.findNextClearBit(164));
+    TEST_ASSERT_EQUAL(320, br.findNextClearBit(165));
+    TEST_ASSERT_EQUAL(329, br.findNextSetBit(320));
+    TEST_ASSERT_EQUAL(0, br.bitPosition);
+
+    // nothing found returns the bit count
+    br.reset(325);
+    TEST_ASSERT_EQUAL(325, br.findNextSetBit(320));
+    TEST_ASSERT_EQUAL(325, br.findNextSetBit(400));
+}
+
+void test_scan_matches_reading_single_bits()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        // sparse set bits so there are long runs to scan
+        buffer[i] = (random(4) == 0) ? (1 << random(8)) : 0;
+    }
+    br.reset(BUFFER_SIZE_IN_BITS - 5);
+
+    for (uint16_t start = 0; start < br.bitCount; start += 7)
+    {
+        br.seek(start);
+        uint16_t expectedPosition = start;
+        uint16_t expectedSetBits = 0;
+        while (expectedPosition < br.bitCount && !br.readBit())
+        {
+            expectedPosition++;
+        }
+        br.seek(start);
+        for (uint16_t i = start; i < br.bitCount; i++)
+        {
+            expectedSetBits += br.readBit();
+        }
+        br.seek(start);
+
+        TEST_ASSERT_EQUAL(expectedPosition, br.findNextSetBit(start));
+        TEST_ASSERT_EQUAL(expectedPosition - start, br.countLeadingZeros());
+        TEST_ASSERT_EQUAL(expectedSetBits, br.popcount(br.bitsRemaining()));
+    }
+}
+
+void test_popcount_of_range()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    memset(buffer, 0, BUFFER_SIZE);
+    buffer[0] = 0b10110000;
+    buffer[1] = 0b00001111;
+    buffer[10] = 0b11111111;
+    br.reset(BUFFER_SIZE_IN_BITS);
+
+    TEST_ASSERT_EQUAL(3, br.popcount(4));
+    TEST_ASSERT_EQUAL(7, br.popcount(16));
+    TEST_ASSERT_EQUAL(15, br.popcount(BUFFER_SIZE_IN_BITS));
+
+    br.seek(2);
+    TEST_ASSERT_EQUAL(2, br.popcount(3));
+    TEST_ASSERT_EQUAL(2, br.bitPosition);
+
+    // only count the bits available
+    br.reset(84);
+    TEST_ASSERT_EQUAL(11, br.popcount(BUFFER_SIZE_IN_BITS));
+}
+
+#ifdef QBB_STATS
+void test_stats_count_reads_and_paths()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(40);
+
+    br.readBit();
+    br.readBits(7);
+    br.readBuffer(readBuffer, 8);
+    br.readBits(3);
+    br.readBuffer(readBuffer, 8);
+    br.readBits(20);
+
+    TEST_ASSERT_EQUAL(1, br.stats.bitCalls);
+    TEST_ASSERT_EQUAL(3, br.stats.bitsCalls);
+    TEST_ASSERT_EQUAL(2, br.stats.bufferCalls);
+    TEST_ASSERT_EQUAL(40, br.stats.bitsTransferred);
+    TEST_ASSERT_EQUAL(1, br.stats.fastPathCalls);
+    TEST_ASSERT_EQUAL(1, br.stats.slowPathCalls);
+    TEST_ASSERT_EQUAL(2, br.stats.alignedCalls);
+    TEST_ASSERT_EQUAL(3, br.stats.unalignedCalls);
+    TEST_ASSERT_EQUAL(1, br.stats.widthCounts[7]);
+    TEST_ASSERT_EQUAL(1, br.stats.widthCounts[20]);
+
+    // the last read asked for more bits than were left, and still read some
+    TEST_ASSERT_EQUAL(1, br.stats.truncatedCalls);
+    TEST_ASSERT_EQUAL(0, br.stats.rejectedCalls);
+
+    // nothing is left to read
+    br.readBit();
+    br.readBits(8);
+    TEST_ASSERT_EQUAL(1, br.stats.truncatedCalls);
+    TEST_ASSERT_EQUAL(2, br.stats.rejectedCalls);
+
+    resetBitStats(&br.stats);
+    TEST_ASSERT_EQUAL(0, br.stats.bitsCalls);
+    TEST_ASSERT_EQUAL(0, br.stats.widthCounts[7]);
+    TEST_ASSERT_EQUAL(0, br.stats.truncatedCalls);
+}
+#endif
+
 void setup()
 {
     delay(4000);
@@ -252,6 +439,15 @@ void setup()
     RUN_TEST(test_reading_state);
     RUN_TEST(test_buffer_reset_multiple_times);
     RUN_TEST(test_zero_returned_for_bits_read_past_available);
+    RUN_TEST(test_seek_moves_read_position);
+    RUN_TEST(test_peek_word_stops_at_available_bits);
+    RUN_TEST(test_count_leading_zeros_and_ones);
+    RUN_TEST(test_find_next_set_and_clear_bits);
+    RUN_TEST(test_scan_matches_reading_single_bits);
+    RUN_TEST(test_popcount_of_range);
+#ifdef QBB_STATS
+    RUN_TEST(test_stats_count_reads_and_paths);
+#endif
 
     UNITY_END();
 }
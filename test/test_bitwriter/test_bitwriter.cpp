@@ -152,6 +152,33 @@ void test_reset_does_not_change_buffer()
     TEST_ASSERT_EACH_EQUAL_INT8(testValue, buffer, BUFFER_SIZE);
 }
 
+#ifdef QBB_STATS
+void test_stats_count_writes_and_rejections()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, 4);
+
+    bw.writeBits(0b101, 3);
+    bw.writeBit(true);
+    bw.writeBits(0xABC, 12);
+    bw.writeBuffer(buffer, 8);
+    bw.writeBits(0xFF, 9);
+
+    TEST_ASSERT_EQUAL(1, bw.stats.bitCalls);
+    TEST_ASSERT_EQUAL(3, bw.stats.bitsCalls);
+    TEST_ASSERT_EQUAL(1, bw.stats.bufferCalls);
+    TEST_ASSERT_EQUAL(24, bw.stats.bitsTransferred);
+    TEST_ASSERT_EQUAL(1, bw.stats.slowPathCalls);
+    TEST_ASSERT_EQUAL(3, bw.stats.alignedCalls);
+    TEST_ASSERT_EQUAL(1, bw.stats.unalignedCalls);
+    TEST_ASSERT_EQUAL(1, bw.stats.widthCounts[3]);
+    TEST_ASSERT_EQUAL(1, bw.stats.widthCounts[12]);
+    TEST_ASSERT_EQUAL(1, bw.stats.widthCounts[9]);
+
+    // the last write did not fit
+    TEST_ASSERT_EQUAL(1, bw.stats.rejectedCalls);
+}
+#endif
+
 void setup()
 {
     delay(4000);
@@ -165,6 +192,9 @@ void setup()
     RUN_TEST(test_bits_remaining);
     RUN_TEST(test_reset_to_start_of_buffer);
     RUN_TEST(test_reset_does_not_change_buffer);
+#ifdef QBB_STATS
+    RUN_TEST(test_stats_count_writes_and_rejections);
+#endif
 
     UNITY_END();
 }
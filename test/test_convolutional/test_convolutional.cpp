@@ -0,0 +1,175 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdlib.h>
+
+long random(long howBig)
+{
+    return rand() % howBig;
+}
+#endif
+#include <unity.h>
+
+#include "Quest_Convolutional.h"
+
+#define BUFFER_SIZE 48
+#define DATA_SIZE 16
+#define DATA_SIZE_IN_BITS DATA_SIZE * 8
+#define CODED_BITS (DATA_SIZE_IN_BITS + QCC_TAIL_BITS) * QCC_CODED_BITS
+
+uint8_t buffer[BUFFER_SIZE];
+uint8_t reencodedBuffer[BUFFER_SIZE];
+uint8_t data[DATA_SIZE];
+uint8_t decodedData[DATA_SIZE];
+
+Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+Quest_ConvolutionalDecoder decoder = Quest_ConvolutionalDecoder(&br);
+
+void encodeRandomData()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_ConvolutionalEncoder encoder = Quest_ConvolutionalEncoder(&bw);
+    for (uint16_t i = 0; i < DATA_SIZE; i++)
+    {
+        data[i] = random(256);
+        encoder.writeBits(data[i], 8);
+    }
+    encoder.flush();
+    br.reset(bw.bitsWritten());
+}
+
+void flipBit(uint16_t position)
+{
+    buffer[position >> 3] ^= QBB_FIRST_BIT >> (position & 0b111);
+}
+
+void test_encoding_writes_two_bits_per_bit_and_tail()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_ConvolutionalEncoder encoder = Quest_ConvolutionalEncoder(&bw);
+    encoder.writeBits(0b1011, 4);
+    TEST_ASSERT_EQUAL(8, bw.bitsWritten());
+    encoder.flush();
+    TEST_ASSERT_EQUAL(12, bw.bitsWritten());
+
+    // generators 7 and 5 starting from state 0
+    TEST_ASSERT_EQUAL(0b11100001, buffer[0]);
+    TEST_ASSERT_EQUAL(0b01110000, buffer[1] & 0b11110000);
+}
+
+void test_decoding_without_errors()
+{
+    encodeRandomData();
+    TEST_ASSERT_EQUAL(CODED_BITS, br.bitCount);
+
+    Quest_BitWriter bw = Quest_BitWriter(decodedData, DATA_SIZE);
+    TEST_ASSERT_EQUAL(DATA_SIZE_IN_BITS, decoder.decode(&bw, DATA_SIZE_IN_BITS));
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, decodedData, DATA_SIZE);
+    TEST_ASSERT_EQUAL(0, decoder.errorMetric);
+    TEST_ASSERT_EQUAL(0, br.bitsRemaining());
+}
+
+void test_decoding_corrects_spread_errors()
+{
+    encodeRandomData();
+
+    // errors far enough apart for the free distance of 5 to correct each one
+    uint8_t errors = 0;
+    for (uint16_t position = 3; position < CODED_BITS; position += 20)
+    {
+        flipBit(position + random(4));
+        errors++;
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(decodedData, DATA_SIZE);
+    TEST_ASSERT_EQUAL(DATA_SIZE_IN_BITS, decoder.decode(&bw, DATA_SIZE_IN_BITS));
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, decodedData, DATA_SIZE);
+    TEST_ASSERT_EQUAL(errors, decoder.errorMetric);
+}
+
+void test_error_metric_matches_decoded_path_under_heavy_noise()
+{
+    for (uint8_t round = 0; round < 50; round++)
+    {
+        encodeRandomData();
+
+        // about 1 in 10 coded bits flipped, more than the code can correct
+        uint8_t errors = 0;
+        for (uint16_t position = 0; position < CODED_BITS; position++)
+        {
+            if (random(10) == 0)
+            {
+                flipBit(position);
+                errors++;
+            }
+        }
+
+        Quest_BitWriter bw = Quest_BitWriter(decodedData, DATA_SIZE);
+        TEST_ASSERT_EQUAL(DATA_SIZE_IN_BITS, decoder.decode(&bw, DATA_SIZE_IN_BITS));
+
+        // the metric is the distance from the received bits to the decoded path
+        Quest_BitWriter reencoded = Quest_BitWriter(reencodedBuffer, BUFFER_SIZE);
+        Quest_ConvolutionalEncoder encoder = Quest_ConvolutionalEncoder(&reencoded);
+        for (uint16_t i = 0; i < DATA_SIZE; i++)
+        {
+            encoder.writeBits(decodedData[i], 8);
+        }
+        encoder.flush();
+
+        uint16_t distance = 0;
+        for (uint16_t position = 0; position < CODED_BITS; position++)
+        {
+            uint8_t mask = QBB_FIRST_BIT >> (position & 0b111);
+            distance += ((buffer[position >> 3] ^ reencodedBuffer[position >> 3]) & mask) != 0;
+        }
+        TEST_ASSERT_EQUAL(distance, decoder.errorMetric);
+
+        // the decoded path is never further away than the path that was sent
+        TEST_ASSERT_LESS_OR_EQUAL(errors, decoder.errorMetric);
+    }
+}
+
+void test_decoding_needs_all_coded_bits_and_room()
+{
+    encodeRandomData();
+    br.reset(CODED_BITS - 1);
+
+    Quest_BitWriter bw = Quest_BitWriter(decodedData, DATA_SIZE);
+    TEST_ASSERT_EQUAL(0, decoder.decode(&bw, DATA_SIZE_IN_BITS));
+    TEST_ASSERT_EQUAL(0, br.bitPosition);
+
+    br.reset(CODED_BITS);
+    Quest_BitWriter smallWriter = Quest_BitWriter(decodedData, DATA_SIZE - 1);
+    TEST_ASSERT_EQUAL(0, decoder.decode(&smallWriter, DATA_SIZE_IN_BITS));
+}
+
+int runUnityTests()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_encoding_writes_two_bits_per_bit_and_tail);
+    RUN_TEST(test_decoding_without_errors);
+    RUN_TEST(test_decoding_corrects_spread_errors);
+    RUN_TEST(test_error_metric_matches_decoded_path_under_heavy_noise);
+    RUN_TEST(test_decoding_needs_all_coded_bits_and_room);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    delay(4000);
+
+    runUnityTests();
+}
+
+void loop()
+{
+}
+#else
+int main(int argc, char **argv)
+{
+    return runUnityTests();
+}
+#endif
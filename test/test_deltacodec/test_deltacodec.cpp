@@ -0,0 +1,329 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#include <stdlib.h>
+
+long random(long howBig)
+{
+    return rand() % howBig;
+}
+
+long random(long howSmall, long howBig)
+{
+    return howSmall + random(howBig - howSmall);
+}
+
+unsigned long micros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+#endif
+#include <unity.h>
+
+#include "Quest_DeltaEncoder.h"
+#include "Quest_DeltaDecoder.h"
+
+#define BUFFER_SIZE 200
+#define BUFFER_SIZE_IN_BITS BUFFER_SIZE * 8
+#define SAMPLE_COUNT 64
+
+uint8_t buffer[BUFFER_SIZE];
+int16_t samples[SAMPLE_COUNT];
+int16_t decodedSamples[SAMPLE_COUNT];
+
+void roundTrip(uint8_t count)
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    uint16_t expectedBits = encoder.blockBits(samples, count);
+    TEST_ASSERT_TRUE(encoder.writeBlock(samples, count));
+    TEST_ASSERT_EQUAL(expectedBits, bw.bitsWritten());
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_DeltaDecoder decoder = Quest_DeltaDecoder(&br);
+    TEST_ASSERT_EQUAL(count, decoder.readBlock(decodedSamples, SAMPLE_COUNT));
+    TEST_ASSERT_EQUAL_INT16_ARRAY(samples, decodedSamples, count);
+    TEST_ASSERT_EQUAL(0, br.bitsRemaining());
+}
+
+void test_slowly_changing_samples_use_delta_mode()
+{
+    // a slow ramp with noise, like an accelerometer axis
+    int16_t value = -20000;
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        value += 40 + random(-20, 21);
+        samples[i] = value;
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    encoder.writeBlock(samples, SAMPLE_COUNT);
+    TEST_ASSERT_LESS_THAN(SAMPLE_COUNT * 16 / 2, bw.bitsWritten());
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    br.readBits(QDC_COUNT_BITS);
+    TEST_ASSERT_EQUAL(QDC_MODE_DELTA, br.readBits(QDC_MODE_BITS));
+
+    roundTrip(SAMPLE_COUNT);
+}
+
+void test_clustered_samples_use_frame_of_reference_mode()
+{
+    // jumping around inside a small window, like a hit sensor at rest
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = 1000 + random(16);
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    encoder.writeBlock(samples, SAMPLE_COUNT);
+    TEST_ASSERT_LESS_OR_EQUAL(QDC_HEADER_BITS + SAMPLE_COUNT * 4, bw.bitsWritten());
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    br.readBits(QDC_COUNT_BITS);
+    TEST_ASSERT_EQUAL(QDC_MODE_FRAME_OF_REFERENCE, br.readBits(QDC_MODE_BITS));
+
+    roundTrip(SAMPLE_COUNT);
+}
+
+void test_extreme_samples_round_trip()
+{
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = (i & 1) ? 32767 : -32768;
+    }
+    roundTrip(SAMPLE_COUNT);
+
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = random(-32768, 32768);
+    }
+    roundTrip(SAMPLE_COUNT);
+}
+
+void test_constant_and_tiny_blocks_only_need_the_header()
+{
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = -42;
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    TEST_ASSERT_EQUAL(QDC_HEADER_BITS, encoder.blockBits(samples, SAMPLE_COUNT));
+    TEST_ASSERT_EQUAL(QDC_HEADER_BITS, encoder.blockBits(samples, 0));
+
+    roundTrip(SAMPLE_COUNT);
+    roundTrip(1);
+
+    samples[0] = 7;
+    roundTrip(1);
+}
+
+void test_multiple_blocks_in_one_buffer()
+{
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = i * 3;
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    bw.writeBits(0b101, 3);
+    TEST_ASSERT_TRUE(encoder.writeBlock(samples, 10));
+    TEST_ASSERT_TRUE(encoder.writeBlock(&samples[10], 20));
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_DeltaDecoder decoder = Quest_DeltaDecoder(&br);
+    TEST_ASSERT_EQUAL(0b101, br.readBits(3));
+    TEST_ASSERT_EQUAL(10, decoder.readBlock(decodedSamples, SAMPLE_COUNT));
+    TEST_ASSERT_EQUAL(20, decoder.readBlock(&decodedSamples[10], SAMPLE_COUNT - 10));
+    TEST_ASSERT_EQUAL_INT16_ARRAY(samples, decodedSamples, 30);
+}
+
+void test_blocks_at_every_bit_offset()
+{
+    for (uint8_t offset = 0; offset < 8; offset++)
+    {
+        // a wider range for each offset, so residual widths vary
+        for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+        {
+            samples[i] = random(-(2 << (offset * 2)), 2 << (offset * 2));
+        }
+
+        Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+        Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+        if (offset > 0)
+        {
+            bw.writeBits(0, offset);
+        }
+        TEST_ASSERT_TRUE(encoder.writeBlock(samples, SAMPLE_COUNT));
+        bw.writeBits(0b1011, 4);
+
+        Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+        br.reset(bw.bitsWritten());
+        Quest_DeltaDecoder decoder = Quest_DeltaDecoder(&br);
+        if (offset > 0)
+        {
+            br.readBits(offset);
+        }
+        TEST_ASSERT_EQUAL(SAMPLE_COUNT, decoder.readBlock(decodedSamples, SAMPLE_COUNT));
+        TEST_ASSERT_EQUAL_INT16_ARRAY(samples, decodedSamples, SAMPLE_COUNT);
+
+        // the reader stops right after the block
+        TEST_ASSERT_EQUAL(0b1011, br.readBits(4));
+        TEST_ASSERT_EQUAL(0, br.bitsRemaining());
+    }
+}
+
+void test_every_residual_width_at_every_bit_offset()
+{
+    // an odd count so blocks end with residuals outside a whole group of 8
+    uint8_t count = SAMPLE_COUNT - 3;
+    for (uint8_t width = 0; width <= 16; width++)
+    {
+        for (uint8_t offset = 0; offset < 8; offset++)
+        {
+            // the largest sample forces the width in frame of reference mode
+            samples[0] = 0;
+            samples[1] = (1L << width) - 1;
+            for (uint8_t i = 2; i < count; i++)
+            {
+                samples[i] = random(1L << width);
+            }
+
+            Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+            Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+            if (offset > 0)
+            {
+                bw.writeBits(0, offset);
+            }
+            TEST_ASSERT_TRUE(encoder.writeBlock(samples, count));
+
+            Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+            br.reset(bw.bitsWritten());
+            Quest_DeltaDecoder decoder = Quest_DeltaDecoder(&br);
+            if (offset > 0)
+            {
+                br.readBits(offset);
+            }
+            TEST_ASSERT_EQUAL(count, decoder.readBlock(decodedSamples, SAMPLE_COUNT));
+            TEST_ASSERT_EQUAL_INT16_ARRAY(samples, decodedSamples, count);
+            TEST_ASSERT_EQUAL(0, br.bitsRemaining());
+        }
+    }
+}
+
+void test_decoding_is_faster_than_reading_each_residual()
+{
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = random(4096);
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    TEST_ASSERT_TRUE(encoder.writeBlock(samples, SAMPLE_COUNT));
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_DeltaDecoder decoder = Quest_DeltaDecoder(&br);
+
+    uint64_t decodeTimes = 0;
+    uint64_t readBitsTimes = 0;
+    uint32_t checksum = 0;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        br.reset(bw.bitsWritten());
+        uint64_t timer = micros();
+        checksum += decoder.readBlock(decodedSamples, SAMPLE_COUNT);
+        decodeTimes += micros() - timer;
+
+        // the same residuals, read one at a time
+        br.reset(bw.bitsWritten());
+        br.readBits(QDC_COUNT_BITS + QDC_MODE_BITS + QDC_BASE_BITS);
+        uint8_t residualWidth = br.readBits(QDC_WIDTH_BITS);
+        timer = micros();
+        for (uint8_t j = 0; j < SAMPLE_COUNT; j++)
+        {
+            checksum += br.readBits(residualWidth);
+        }
+        readBitsTimes += micros() - timer;
+    }
+    TEST_ASSERT_TRUE(checksum > 0);
+
+    // decoding the whole block should be at least twice as fast
+    TEST_ASSERT_GREATER_OR_EQUAL(2 * decodeTimes, readBitsTimes);
+}
+
+void test_block_must_fit_writer_and_destination()
+{
+    for (uint8_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = random(-32768, 32768);
+    }
+
+    // the writer is left untouched when the block does not fit
+    Quest_BitWriter smallWriter = Quest_BitWriter(buffer, 8);
+    Quest_DeltaEncoder smallEncoder = Quest_DeltaEncoder(&smallWriter);
+    TEST_ASSERT_FALSE(smallEncoder.writeBlock(samples, SAMPLE_COUNT));
+    TEST_ASSERT_EQUAL(0, smallWriter.bitsWritten());
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_DeltaEncoder encoder = Quest_DeltaEncoder(&bw);
+    encoder.writeBlock(samples, 20);
+
+    // the destination is too small
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_DeltaDecoder decoder = Quest_DeltaDecoder(&br);
+    TEST_ASSERT_EQUAL(0, decoder.readBlock(decodedSamples, 10));
+
+    // the block is truncated
+    br.reset(bw.bitsWritten() - 1);
+    TEST_ASSERT_EQUAL(0, decoder.readBlock(decodedSamples, SAMPLE_COUNT));
+}
+
+int runUnityTests()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_slowly_changing_samples_use_delta_mode);
+    RUN_TEST(test_clustered_samples_use_frame_of_reference_mode);
+    RUN_TEST(test_extreme_samples_round_trip);
+    RUN_TEST(test_constant_and_tiny_blocks_only_need_the_header);
+    RUN_TEST(test_multiple_blocks_in_one_buffer);
+    RUN_TEST(test_blocks_at_every_bit_offset);
+    RUN_TEST(test_every_residual_width_at_every_bit_offset);
+    RUN_TEST(test_decoding_is_faster_than_reading_each_residual);
+    RUN_TEST(test_block_must_fit_writer_and_destination);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup()
+{
+    delay(4000);
+
+    runUnityTests();
+}
+
+void loop()
+{
+}
+#else
+int main(int argc, char **argv)
+{
+    return runUnityTests();
+}
+#endif
@@ -0,0 +1,290 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "Quest_DoubleBufferedWriter.h"
+
+#define BUFFER_SIZE 8
+#define BUFFER_SIZE_IN_BITS BUFFER_SIZE * 8
+#define STREAM_SIZE 200
+#define FIELD_COUNT 48
+
+// Quest_BitWriter::writeBuffer loads the byte after the last one it finishes, so give it a spare
+uint8_t buffer0[BUFFER_SIZE + 1];
+uint8_t buffer1[BUFFER_SIZE + 1];
+uint8_t expectedStream[STREAM_SIZE];
+uint8_t transmittedStream[STREAM_SIZE];
+
+uint32_t fieldBits[FIELD_COUNT];
+uint8_t fieldWidths[FIELD_COUNT];
+
+// a simulated DMA channel, the buffer is only read when the transfer completes
+struct SimulatedDMA
+{
+    Quest_DoubleBufferedWriter *writer;
+    Quest_BitWriter *transmitted;
+    bool completeImmediately;
+    uint8_t *pendingBuffer;
+    uint16_t pendingBitCount;
+    uint16_t transmitCount;
+    uint16_t backpressureCount;
+};
+
+void completeTransfer(SimulatedDMA *dma)
+{
+    dma->transmitted->writeBuffer(dma->pendingBuffer, dma->pendingBitCount);
+    dma->pendingBuffer = NULL;
+    dma->writer->transmitComplete();
+}
+
+void startTransfer(uint8_t *buffer, uint16_t bitCount, void *context)
+{
+    SimulatedDMA *dma = (SimulatedDMA *)context;
+    TEST_ASSERT_TRUE(dma->pendingBuffer == NULL);
+
+    dma->pendingBuffer = buffer;
+    dma->pendingBitCount = bitCount;
+    dma->transmitCount++;
+    if (dma->completeImmediately)
+    {
+        completeTransfer(dma);
+    }
+}
+
+void waitForTransfer(void *context)
+{
+    SimulatedDMA *dma = (SimulatedDMA *)context;
+    dma->backpressureCount++;
+    completeTransfer(dma);
+}
+
+void randomizeFields()
+{
+    Quest_BitWriter expectedWriter = Quest_BitWriter(expectedStream, STREAM_SIZE);
+    for (uint16_t i = 0; i < FIELD_COUNT; i++)
+    {
+        fieldWidths[i] = random(1, 33);
+        fieldBits[i] = random(0x7FFFFFFF) ^ (random(2) << 31);
+        expectedWriter.writeBits(fieldBits[i], fieldWidths[i]);
+    }
+}
+
+uint32_t expectedBits()
+{
+    uint32_t bits = 0;
+    for (uint16_t i = 0; i < FIELD_COUNT; i++)
+    {
+        bits += fieldWidths[i];
+    }
+    return bits;
+}
+
+void writeFieldsAndCompare(bool completeImmediately, bool useBackpressure)
+{
+    randomizeFields();
+    memset(transmittedStream, 0, STREAM_SIZE);
+
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    SimulatedDMA dma = {NULL, &transmitted, completeImmediately, NULL, 0, 0, 0};
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(buffer0, buffer1, BUFFER_SIZE, startTransfer, &dma);
+    dma.writer = &writer;
+    if (useBackpressure)
+    {
+        writer.setBackpressureCallback(waitForTransfer);
+    }
+
+    for (uint16_t i = 0; i < FIELD_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(writer.writeBits(fieldBits[i], fieldWidths[i]));
+    }
+    TEST_ASSERT_TRUE(writer.flush());
+    if (writer.isTransmitting())
+    {
+        completeTransfer(&dma);
+    }
+
+    uint32_t bits = expectedBits();
+    TEST_ASSERT_EQUAL(bits, writer.bitsWritten());
+    TEST_ASSERT_EQUAL(bits, transmitted.bitsWritten());
+    TEST_ASSERT_EQUAL((bits + (BUFFER_SIZE_IN_BITS) - 1) / (BUFFER_SIZE_IN_BITS), dma.transmitCount);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(expectedStream, transmittedStream, bits / 8);
+    if (!completeImmediately)
+    {
+        TEST_ASSERT_GREATER_OR_EQUAL(1, dma.backpressureCount);
+    }
+}
+
+void test_immediate_transmit_matches_single_writer()
+{
+    writeFieldsAndCompare(true, false);
+}
+
+void test_deferred_transmit_with_backpressure_matches_single_writer()
+{
+    writeFieldsAndCompare(false, true);
+}
+
+void test_full_buffer_is_transmitted_right_away()
+{
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    SimulatedDMA dma = {NULL, &transmitted, false, NULL, 0, 0, 0};
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(buffer0, buffer1, BUFFER_SIZE, startTransfer, &dma);
+    dma.writer = &writer;
+
+    // the first buffer is sent as soon as it is full
+    writer.writeBits(0xABCDEF12, 32);
+    TEST_ASSERT_EQUAL(0, dma.transmitCount);
+    writer.writeBits(0x3456789A, 32);
+    TEST_ASSERT_EQUAL(1, dma.transmitCount);
+    TEST_ASSERT_TRUE(dma.pendingBuffer == buffer0);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS, dma.pendingBitCount);
+    TEST_ASSERT_TRUE(writer.isTransmitting());
+
+    // writing continues in the second buffer while the first is sent
+    writer.writeBits(0xB, 4);
+    completeTransfer(&dma);
+    TEST_ASSERT_FALSE(writer.isTransmitting());
+
+    // flushing sends the partial buffer
+    TEST_ASSERT_TRUE(writer.flush());
+    TEST_ASSERT_TRUE(dma.pendingBuffer == buffer1);
+    TEST_ASSERT_EQUAL(4, dma.pendingBitCount);
+    completeTransfer(&dma);
+
+    TEST_ASSERT_EQUAL(0xAB, transmittedStream[0]);
+    TEST_ASSERT_EQUAL(0x9A, transmittedStream[7]);
+    TEST_ASSERT_EQUAL(0xB0, transmittedStream[8] & 0xF0);
+}
+
+void test_writes_fail_when_both_buffers_are_busy()
+{
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    SimulatedDMA dma = {NULL, &transmitted, false, NULL, 0, 0, 0};
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(buffer0, buffer1, BUFFER_SIZE, startTransfer, &dma);
+    dma.writer = &writer;
+
+    // the first buffer is transmitting and the second buffer fills up
+    for (uint8_t i = 0; i < BUFFER_SIZE * 2; i++)
+    {
+        TEST_ASSERT_TRUE(writer.writeBits(i, 8));
+    }
+    TEST_ASSERT_EQUAL(1, dma.transmitCount);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS * 2, writer.bitsWritten());
+
+    // nothing is written until the transmission completes
+    TEST_ASSERT_FALSE(writer.writeBit(true));
+    TEST_ASSERT_FALSE(writer.flush());
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS * 2, writer.bitsWritten());
+
+    completeTransfer(&dma);
+    TEST_ASSERT_TRUE(writer.writeBit(true));
+    TEST_ASSERT_EQUAL(2, dma.transmitCount);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS * 2 + 1, writer.bitsWritten());
+}
+
+void test_failed_buffer_write_writes_nothing()
+{
+    uint8_t smallBuffer0[4];
+    uint8_t smallBuffer1[4];
+    uint8_t sourceBuffer[4] = {0x12, 0x34, 0x56, 0x78};
+
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    SimulatedDMA dma = {NULL, &transmitted, false, NULL, 0, 0, 0};
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(smallBuffer0, smallBuffer1, 4, startTransfer, &dma);
+    dma.writer = &writer;
+
+    // the first buffer is transmitting and the second holds 16 bits
+    TEST_ASSERT_TRUE(writer.writeBits(0xAABBCCDD, 32));
+    TEST_ASSERT_TRUE(writer.writeBits(0xEEFF, 16));
+    TEST_ASSERT_TRUE(writer.isTransmitting());
+    TEST_ASSERT_EQUAL(48, writer.bitsWritten());
+
+    // 32 bits do not fit in the 16 bits left, so none are written
+    TEST_ASSERT_FALSE(writer.writeBuffer(sourceBuffer, 32));
+    TEST_ASSERT_EQUAL(48, writer.bitsWritten());
+
+    // 16 bits still fit
+    TEST_ASSERT_TRUE(writer.writeBuffer(sourceBuffer, 16));
+    TEST_ASSERT_EQUAL(64, writer.bitsWritten());
+    TEST_ASSERT_EQUAL(1, dma.transmitCount);
+}
+
+void test_reset_during_transmit_keeps_the_transmitting_buffer()
+{
+    uint8_t smallBuffer0[4 + 1];
+    uint8_t smallBuffer1[4 + 1];
+
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    SimulatedDMA dma = {NULL, &transmitted, false, NULL, 0, 0, 0};
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(smallBuffer0, smallBuffer1, 4, startTransfer, &dma);
+    dma.writer = &writer;
+
+    // the first buffer fills and starts transmitting
+    TEST_ASSERT_TRUE(writer.writeBits(0x12345678, 32));
+    TEST_ASSERT_TRUE(writer.isTransmitting());
+    TEST_ASSERT_TRUE(dma.pendingBuffer == smallBuffer0);
+
+    // starting over must not write into the buffer being transmitted
+    writer.reset();
+    TEST_ASSERT_EQUAL(0, writer.bitsWritten());
+    TEST_ASSERT_TRUE(writer.writeBits(0xAABB, 16));
+    TEST_ASSERT_EQUAL(16, writer.bitsWritten());
+    TEST_ASSERT_EQUAL(0x12, smallBuffer0[0]);
+    TEST_ASSERT_EQUAL(0x34, smallBuffer0[1]);
+    TEST_ASSERT_EQUAL(0x56, smallBuffer0[2]);
+    TEST_ASSERT_EQUAL(0x78, smallBuffer0[3]);
+
+    // the transfer completes with the original bits, and the new bits follow
+    completeTransfer(&dma);
+    TEST_ASSERT_TRUE(writer.flush());
+    completeTransfer(&dma);
+    TEST_ASSERT_EQUAL(48, transmitted.bitsWritten());
+    TEST_ASSERT_EQUAL(0x12, transmittedStream[0]);
+    TEST_ASSERT_EQUAL(0x78, transmittedStream[3]);
+    TEST_ASSERT_EQUAL(0xAA, transmittedStream[4]);
+    TEST_ASSERT_EQUAL(0xBB, transmittedStream[5]);
+}
+
+void test_writing_from_another_buffer()
+{
+    for (uint16_t i = 0; i < STREAM_SIZE; i++)
+    {
+        expectedStream[i] = random(256);
+    }
+    memset(transmittedStream, 0, STREAM_SIZE);
+
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    SimulatedDMA dma = {NULL, &transmitted, true, NULL, 0, 0, 0};
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(buffer0, buffer1, BUFFER_SIZE, startTransfer, &dma);
+    writer.setBackpressureCallback(waitForTransfer);
+    dma.writer = &writer;
+
+    // the source spans many buffers, which needs backpressure to be written in one call
+    uint16_t bitsToWrite = STREAM_SIZE * 4 + 5;
+    TEST_ASSERT_TRUE(writer.writeBuffer(expectedStream, bitsToWrite));
+    writer.flush();
+
+    TEST_ASSERT_EQUAL(bitsToWrite, transmitted.bitsWritten());
+    TEST_ASSERT_EQUAL_INT8_ARRAY(expectedStream, transmittedStream, bitsToWrite / 8);
+    TEST_ASSERT_EQUAL(expectedStream[bitsToWrite / 8] & 0b11111000, transmittedStream[bitsToWrite / 8]);
+}
+
+void setup()
+{
+    delay(4000);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_immediate_transmit_matches_single_writer);
+    RUN_TEST(test_deferred_transmit_with_backpressure_matches_single_writer);
+    RUN_TEST(test_full_buffer_is_transmitted_right_away);
+    RUN_TEST(test_writes_fail_when_both_buffers_are_busy);
+    RUN_TEST(test_failed_buffer_write_writes_nothing);
+    RUN_TEST(test_reset_during_transmit_keeps_the_transmitting_buffer);
+    RUN_TEST(test_writing_from_another_buffer);
+
+    UNITY_END();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,119 @@
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdlib.h>
+#include <thread>
+
+#include "Quest_DoubleBufferedWriter.h"
+
+#define BUFFER_SIZE 8
+#define STREAM_SIZE 250
+
+// Quest_BitWriter::writeBuffer loads the byte after the last one it finishes, so give it a spare
+uint8_t buffer0[BUFFER_SIZE + 1];
+uint8_t buffer1[BUFFER_SIZE + 1];
+uint8_t expectedStream[STREAM_SIZE];
+uint8_t transmittedStream[STREAM_SIZE];
+
+// a DMA channel simulated by a thread, completion arrives asynchronously like the DMA interrupt
+struct ThreadedDMA
+{
+    Quest_DoubleBufferedWriter *writer;
+    Quest_BitWriter *transmitted;
+    std::atomic<uint8_t *> pendingBuffer;
+    std::atomic<uint16_t> pendingBitCount;
+    std::atomic<bool> stopping;
+    std::atomic<uint16_t> transmitCount;
+    std::atomic<uint32_t> backpressureCount;
+};
+
+void runTransfers(ThreadedDMA *dma)
+{
+    while (!dma->stopping || dma->pendingBuffer != NULL)
+    {
+        uint8_t *buffer = dma->pendingBuffer;
+        if (buffer == NULL)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // the buffer is only read once the transfer has taken some time
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+        dma->transmitted->writeBuffer(buffer, dma->pendingBitCount);
+        dma->pendingBuffer = NULL;
+        dma->writer->transmitComplete();
+    }
+}
+
+void startTransfer(uint8_t *buffer, uint16_t bitCount, void *context)
+{
+    ThreadedDMA *dma = (ThreadedDMA *)context;
+    TEST_ASSERT_TRUE(dma->pendingBuffer == NULL);
+
+    dma->transmitCount++;
+    dma->pendingBitCount = bitCount;
+    dma->pendingBuffer = buffer;
+}
+
+void waitForTransfer(void *context)
+{
+    ThreadedDMA *dma = (ThreadedDMA *)context;
+    dma->backpressureCount++;
+    std::this_thread::yield();
+}
+
+void test_threaded_transmit_matches_single_writer()
+{
+    Quest_BitWriter expectedWriter = Quest_BitWriter(expectedStream, STREAM_SIZE);
+    Quest_BitWriter transmitted = Quest_BitWriter(transmittedStream, STREAM_SIZE);
+    memset(expectedStream, 0, STREAM_SIZE);
+    memset(transmittedStream, 0, STREAM_SIZE);
+
+    ThreadedDMA dma;
+    dma.transmitted = &transmitted;
+    dma.pendingBuffer = NULL;
+    dma.pendingBitCount = 0;
+    dma.stopping = false;
+    dma.transmitCount = 0;
+    dma.backpressureCount = 0;
+
+    Quest_DoubleBufferedWriter writer = Quest_DoubleBufferedWriter(buffer0, buffer1, BUFFER_SIZE, startTransfer, &dma);
+    writer.setBackpressureCallback(waitForTransfer);
+    dma.writer = &writer;
+    std::thread dmaThread(runTransfers, &dma);
+
+    // fill the stream with fields of random widths
+    while (expectedWriter.bitsRemaining() >= 32)
+    {
+        uint8_t width = 1 + rand() % 32;
+        uint32_t bits = rand() ^ ((uint32_t)rand() << 16);
+        expectedWriter.writeBits(bits, width);
+        TEST_ASSERT_TRUE(writer.writeBits(bits, width));
+    }
+    TEST_ASSERT_TRUE(writer.flush());
+
+    dma.stopping = true;
+    dmaThread.join();
+
+    TEST_ASSERT_FALSE(writer.isTransmitting());
+    TEST_ASSERT_EQUAL(expectedWriter.bitsWritten(), writer.bitsWritten());
+    TEST_ASSERT_EQUAL(expectedWriter.bitsWritten(), transmitted.bitsWritten());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedStream, transmittedStream, STREAM_SIZE);
+    TEST_ASSERT_GREATER_OR_EQUAL(expectedWriter.bitsWritten() / (BUFFER_SIZE * 8), dma.transmitCount);
+
+    // the writer outpaces the simulated transfers, so it must have waited
+    TEST_ASSERT_TRUE(dma.backpressureCount > 0);
+}
+
+int main(int argc, char **argv)
+{
+    srand(1);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_threaded_transmit_matches_single_writer);
+
+    return UNITY_END();
+}
@@ -0,0 +1,133 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "Quest_Hamming.h"
+
+#define BUFFER_SIZE 48
+#define DATA_SIZE 16
+
+uint8_t buffer[BUFFER_SIZE];
+uint8_t data[DATA_SIZE];
+
+void randomizeData()
+{
+    for (uint16_t i = 0; i < DATA_SIZE; i++)
+    {
+        data[i] = random(256);
+    }
+}
+
+uint16_t encodeData(bool extendedParity)
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_HammingEncoder encoder = Quest_HammingEncoder(&bw, extendedParity);
+    for (uint16_t i = 0; i < DATA_SIZE; i++)
+    {
+        encoder.writeBits(data[i], 8);
+    }
+    encoder.flush();
+    return bw.bitsWritten();
+}
+
+void flipBit(uint16_t position)
+{
+    buffer[position >> 3] ^= QBB_FIRST_BIT >> (position & 0b111);
+}
+
+void test_codeword_sizes()
+{
+    randomizeData();
+    TEST_ASSERT_EQUAL(DATA_SIZE * 2 * QHC_CODEWORD_BITS, encodeData(false));
+    TEST_ASSERT_EQUAL(DATA_SIZE * 2 * QHC_EXTENDED_CODEWORD_BITS, encodeData(true));
+}
+
+void test_partial_nibble_is_padded_on_flush()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_HammingEncoder encoder = Quest_HammingEncoder(&bw, true);
+    encoder.writeBits(0b101101, 6);
+    TEST_ASSERT_EQUAL(QHC_EXTENDED_CODEWORD_BITS, bw.bitsWritten());
+    encoder.flush();
+    TEST_ASSERT_EQUAL(2 * QHC_EXTENDED_CODEWORD_BITS, bw.bitsWritten());
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_HammingDecoder decoder = Quest_HammingDecoder(&br, true);
+    TEST_ASSERT_EQUAL(0b101, decoder.readBits(3));
+    TEST_ASSERT_EQUAL(0b10100, decoder.readBits(5));
+}
+
+void test_single_bit_errors_are_corrected()
+{
+    for (uint8_t extended = 0; extended < 2; extended++)
+    {
+        randomizeData();
+        uint16_t bitsWritten = encodeData(extended);
+        uint8_t codewordBits = extended ? QHC_EXTENDED_CODEWORD_BITS : QHC_CODEWORD_BITS;
+
+        // flip one bit in every codeword
+        for (uint16_t codeword = 0; codeword < DATA_SIZE * 2; codeword++)
+        {
+            flipBit(codeword * codewordBits + random(codewordBits));
+        }
+
+        Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+        br.reset(bitsWritten);
+        Quest_HammingDecoder decoder = Quest_HammingDecoder(&br, extended);
+        for (uint16_t i = 0; i < DATA_SIZE; i++)
+        {
+            TEST_ASSERT_EQUAL(data[i], decoder.readBits(8));
+        }
+        TEST_ASSERT_EQUAL(DATA_SIZE * 2, decoder.correctedErrors);
+        TEST_ASSERT_EQUAL(0, decoder.uncorrectableErrors);
+    }
+}
+
+void test_double_bit_errors_are_detected_with_extended_parity()
+{
+    randomizeData();
+    uint16_t bitsWritten = encodeData(true);
+
+    // flip two different bits in the first codeword
+    flipBit(1);
+    flipBit(6);
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bitsWritten);
+    Quest_HammingDecoder decoder = Quest_HammingDecoder(&br, true);
+    decoder.readBits(8);
+    TEST_ASSERT_EQUAL(0, decoder.correctedErrors);
+    TEST_ASSERT_EQUAL(1, decoder.uncorrectableErrors);
+
+    // the reset clears the error counts
+    decoder.reset();
+    TEST_ASSERT_EQUAL(0, decoder.uncorrectableErrors);
+}
+
+void test_encoding_past_buffer_end_fails()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, 2);
+    Quest_HammingEncoder encoder = Quest_HammingEncoder(&bw, true);
+    TEST_ASSERT_TRUE(encoder.writeBits(0xAB, 8));
+    TEST_ASSERT_FALSE(encoder.writeBits(0xCD, 8));
+    TEST_ASSERT_EQUAL(16, bw.bitsWritten());
+}
+
+void setup()
+{
+    delay(4000);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_codeword_sizes);
+    RUN_TEST(test_partial_nibble_is_padded_on_flush);
+    RUN_TEST(test_single_bit_errors_are_corrected);
+    RUN_TEST(test_double_bit_errors_are_detected_with_extended_parity);
+    RUN_TEST(test_encoding_past_buffer_end_fails);
+
+    UNITY_END();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,114 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "Quest_Interleaver.h"
+
+#define BUFFER_SIZE 48
+#define BUFFER_SIZE_IN_BITS BUFFER_SIZE * 8
+
+uint8_t buffer[BUFFER_SIZE];
+uint8_t interleavedBuffer[BUFFER_SIZE];
+uint8_t deinterleavedBuffer[BUFFER_SIZE];
+
+void randomizeBuffer()
+{
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        buffer[i] = random(256);
+    }
+}
+
+void test_interleaving_by_depth()
+{
+    buffer[0] = 0b11110000;
+    buffer[1] = 0b10100000;
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(12);
+    Quest_BitWriter bw = Quest_BitWriter(interleavedBuffer, BUFFER_SIZE);
+    TEST_ASSERT_TRUE(interleaveBits(&br, &bw, 12, 4));
+    TEST_ASSERT_EQUAL(12, br.bitPosition);
+    TEST_ASSERT_EQUAL(12, bw.bitsWritten());
+
+    // columns are bits 0,4,8 then 1,5,9 then 2,6,10 then 3,7,11
+    TEST_ASSERT_EQUAL(0b10110010, interleavedBuffer[0]);
+    TEST_ASSERT_EQUAL(0b11000000, interleavedBuffer[1] & 0b11110000);
+}
+
+void test_deinterleaving_restores_bits()
+{
+    uint8_t depths[] = {1, 3, 7, 8, 13};
+    for (uint8_t d = 0; d < sizeof(depths); d++)
+    {
+        randomizeBuffer();
+        uint16_t bitsToCopy = BUFFER_SIZE_IN_BITS - random(20);
+
+        Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+        Quest_BitWriter bw = Quest_BitWriter(interleavedBuffer, BUFFER_SIZE);
+        TEST_ASSERT_TRUE(interleaveBits(&br, &bw, bitsToCopy, depths[d]));
+
+        Quest_BitReader interleavedReader = Quest_BitReader(interleavedBuffer, BUFFER_SIZE);
+        Quest_BitWriter deinterleavedWriter = Quest_BitWriter(deinterleavedBuffer, BUFFER_SIZE);
+        TEST_ASSERT_TRUE(deinterleaveBits(&interleavedReader, &deinterleavedWriter, bitsToCopy, depths[d]));
+
+        TEST_ASSERT_EQUAL_INT8_ARRAY(buffer, deinterleavedBuffer, bitsToCopy / 8);
+    }
+}
+
+void test_burst_is_spread_by_depth()
+{
+    memset(buffer, 0, BUFFER_SIZE);
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    Quest_BitWriter bw = Quest_BitWriter(interleavedBuffer, BUFFER_SIZE);
+    interleaveBits(&br, &bw, BUFFER_SIZE_IN_BITS, 8);
+
+    // a burst of 8 errors on the link
+    interleavedBuffer[10] = 0xFF;
+
+    Quest_BitReader interleavedReader = Quest_BitReader(interleavedBuffer, BUFFER_SIZE);
+    Quest_BitWriter deinterleavedWriter = Quest_BitWriter(deinterleavedBuffer, BUFFER_SIZE);
+    deinterleaveBits(&interleavedReader, &deinterleavedWriter, BUFFER_SIZE_IN_BITS, 8);
+
+    // each error lands in a different byte
+    Quest_BitReader errorReader = Quest_BitReader(deinterleavedBuffer, BUFFER_SIZE);
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        TEST_ASSERT_LESS_OR_EQUAL(1, errorReader.popcount(8));
+        errorReader.seek(errorReader.bitPosition + 8);
+    }
+    errorReader.seek(0);
+    TEST_ASSERT_EQUAL(8, errorReader.popcount(BUFFER_SIZE_IN_BITS));
+}
+
+void test_not_enough_bits_or_room_fails()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(10);
+    Quest_BitWriter bw = Quest_BitWriter(interleavedBuffer, BUFFER_SIZE);
+    TEST_ASSERT_FALSE(interleaveBits(&br, &bw, 11, 4));
+    TEST_ASSERT_FALSE(interleaveBits(&br, &bw, 10, 0));
+
+    Quest_BitWriter smallWriter = Quest_BitWriter(interleavedBuffer, 1);
+    TEST_ASSERT_FALSE(deinterleaveBits(&br, &smallWriter, 10, 4));
+    TEST_ASSERT_EQUAL(0, br.bitPosition);
+    TEST_ASSERT_EQUAL(0, smallWriter.bitsWritten());
+}
+
+void setup()
+{
+    delay(4000);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_interleaving_by_depth);
+    RUN_TEST(test_deinterleaving_restores_bits);
+    RUN_TEST(test_burst_is_spread_by_depth);
+    RUN_TEST(test_not_enough_bits_or_room_fails);
+
+    UNITY_END();
+}
+
+void loop()
+{
+}
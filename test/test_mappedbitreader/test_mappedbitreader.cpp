@@ -0,0 +1,334 @@
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+#include "Quest_BitReader.h"
+#include "Quest_MappedBitReader.h"
+
+#define BUFFER_SIZE 48
+#define BUFFER_SIZE_IN_BITS (BUFFER_SIZE * 8)
+#define FRAME_SIZE_IN_BITS 24
+
+// Quest_BitReader loads the byte after the last one it finishes, so give it a spare
+uint8_t buffer[BUFFER_SIZE + 1];
+uint8_t readBuffer[BUFFER_SIZE];
+uint8_t expectedBuffer[BUFFER_SIZE];
+char capturePath[] = "/tmp/test_mappedbitreaderXXXXXX";
+
+void writeCapture(const uint8_t *data, size_t length)
+{
+    FILE *file = fopen(capturePath, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(length, fwrite(data, 1, length, file));
+    fclose(file);
+}
+
+void writeIndex(const void *data, size_t length)
+{
+    std::string indexPath = std::string(capturePath) + ".idx";
+    FILE *file = fopen(indexPath.c_str(), "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(length, fwrite(data, 1, length, file));
+    fclose(file);
+}
+
+bool readFixedFrame(Quest_MappedBitReader *reader, void *context)
+{
+    return reader->seek(reader->bitPosition + FRAME_SIZE_IN_BITS);
+}
+
+// matches the on-disk header written by saveFrameIndex
+struct IndexFile
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t captureLength;
+    uint64_t frameCount;
+    uint64_t entries[4];
+};
+
+IndexFile validIndex()
+{
+    IndexFile index;
+    index.magic = 0x49424251;
+    index.version = 1;
+    index.captureLength = BUFFER_SIZE;
+    index.frameCount = 4;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        index.entries[i] = i * FRAME_SIZE_IN_BITS;
+    }
+    return index;
+}
+
+void setUp()
+{
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+    {
+        buffer[i] = rand();
+    }
+    writeCapture(buffer, BUFFER_SIZE);
+}
+
+void tearDown()
+{
+    std::string indexPath = std::string(capturePath) + ".idx";
+    unlink(indexPath.c_str());
+}
+
+void test_open_maps_full_capture()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS, mbr.bitCount);
+    TEST_ASSERT_EQUAL(0, mbr.bitPosition);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS, mbr.bitsRemaining());
+}
+
+void test_open_missing_file_fails()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_FALSE(mbr.open("/tmp/test_mappedbitreader_missing"));
+    TEST_ASSERT_EQUAL(0, mbr.bitCount);
+}
+
+void test_open_empty_capture()
+{
+    writeCapture(buffer, 0);
+
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_EQUAL(0, mbr.bitCount);
+    TEST_ASSERT_FALSE(mbr.readBit());
+    TEST_ASSERT_EQUAL(0, mbr.readBuffer(readBuffer, 8));
+}
+
+void test_read_bits_matches_bit_reader()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+
+    // walk every width so reads cross byte boundaries at every offset
+    uint8_t width = 1;
+    while (br.bitsRemaining() > 0)
+    {
+        TEST_ASSERT_EQUAL(br.bitPosition, mbr.bitPosition);
+        TEST_ASSERT_EQUAL_HEX32(br.readBits(width), mbr.readBits(width));
+        width = width % 32 + 1;
+    }
+    TEST_ASSERT_EQUAL(br.bitPosition, mbr.bitPosition);
+    TEST_ASSERT_EQUAL(0, mbr.readBits(8));
+}
+
+void test_reads_wider_than_32_bits_match_bit_reader()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+
+    br.readBits(3);
+    mbr.readBits(3);
+    TEST_ASSERT_EQUAL_HEX32(br.readBits(40), mbr.readBits(40));
+    TEST_ASSERT_EQUAL(43, mbr.bitPosition);
+    TEST_ASSERT_EQUAL_HEX32(br.readBits(64), mbr.readBits(64));
+    TEST_ASSERT_EQUAL(107, mbr.bitPosition);
+
+    // clamped at the end of the capture like any other read
+    TEST_ASSERT_TRUE(mbr.seek(BUFFER_SIZE_IN_BITS - 36));
+    br.reset(BUFFER_SIZE_IN_BITS);
+    br.readBits(BUFFER_SIZE_IN_BITS - 36 - 200);
+    br.readBits(200);
+    TEST_ASSERT_EQUAL_HEX32(br.readBits(40), mbr.readBits(40));
+    TEST_ASSERT_EQUAL(0, mbr.bitsRemaining());
+}
+
+void test_read_bit_matches_bit_reader()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+
+    for (uint16_t i = 0; i < BUFFER_SIZE_IN_BITS; i++)
+    {
+        TEST_ASSERT_EQUAL(br.readBit(), mbr.readBit());
+    }
+}
+
+void test_read_buffer_matches_bit_reader()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+
+    for (uint8_t offset = 0; offset < 8; offset++)
+    {
+        uint16_t bitsToRead = BUFFER_SIZE_IN_BITS - 8 - offset;
+        memset(readBuffer, 0, BUFFER_SIZE);
+        memset(expectedBuffer, 0, BUFFER_SIZE);
+
+        Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+        br.readBits(offset);
+        TEST_ASSERT_EQUAL(bitsToRead, br.readBuffer(expectedBuffer, bitsToRead));
+
+        TEST_ASSERT_TRUE(mbr.seek(offset));
+        TEST_ASSERT_EQUAL(bitsToRead, mbr.readBuffer(readBuffer, bitsToRead));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedBuffer, readBuffer, BUFFER_SIZE);
+    }
+}
+
+void test_read_buffer_is_clamped_to_capture()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_TRUE(mbr.seek(BUFFER_SIZE_IN_BITS - 12));
+
+    TEST_ASSERT_EQUAL(12, mbr.readBuffer(readBuffer, 40));
+    TEST_ASSERT_EQUAL(0, mbr.bitsRemaining());
+}
+
+void test_build_save_and_load_frame_index()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS / FRAME_SIZE_IN_BITS, mbr.buildFrameIndex(readFixedFrame, NULL));
+    TEST_ASSERT_TRUE(mbr.saveFrameIndex());
+
+    Quest_MappedBitReader loaded;
+    TEST_ASSERT_TRUE(loaded.open(capturePath));
+    TEST_ASSERT_EQUAL(0, loaded.frameCount());
+    TEST_ASSERT_TRUE(loaded.loadFrameIndex());
+    TEST_ASSERT_EQUAL(mbr.frameCount(), loaded.frameCount());
+    for (uint32_t i = 0; i < loaded.frameCount(); i++)
+    {
+        TEST_ASSERT_EQUAL(i * FRAME_SIZE_IN_BITS, loaded.frameBitPosition(i));
+    }
+}
+
+void test_seek_to_frame()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    mbr.buildFrameIndex(readFixedFrame, NULL);
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.readBits(FRAME_SIZE_IN_BITS * 3);
+
+    TEST_ASSERT_TRUE(mbr.seekToFrame(3));
+    TEST_ASSERT_EQUAL(FRAME_SIZE_IN_BITS * 3, mbr.bitPosition);
+    TEST_ASSERT_EQUAL_HEX32(br.readBits(FRAME_SIZE_IN_BITS), mbr.readBits(FRAME_SIZE_IN_BITS));
+
+    TEST_ASSERT_FALSE(mbr.seekToFrame(mbr.frameCount()));
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS, mbr.frameBitPosition(mbr.frameCount()));
+}
+
+void test_load_missing_index_fails()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+    TEST_ASSERT_EQUAL(0, mbr.frameCount());
+}
+
+void test_load_valid_index()
+{
+    IndexFile index = validIndex();
+    writeIndex(&index, sizeof(index));
+
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_TRUE(mbr.loadFrameIndex());
+    TEST_ASSERT_EQUAL(4, mbr.frameCount());
+    TEST_ASSERT_EQUAL(FRAME_SIZE_IN_BITS * 3, mbr.frameBitPosition(3));
+}
+
+void test_load_stale_index_fails()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    mbr.buildFrameIndex(readFixedFrame, NULL);
+    TEST_ASSERT_TRUE(mbr.saveFrameIndex());
+
+    // the capture shrank after the index was saved
+    writeCapture(buffer, BUFFER_SIZE - 4);
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+    TEST_ASSERT_EQUAL(0, mbr.frameCount());
+}
+
+void test_load_index_with_corrupt_frame_count_fails()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+
+    IndexFile index = validIndex();
+    index.frameCount = 0x4000000000000000ULL;
+    writeIndex(&index, sizeof(index));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+    TEST_ASSERT_EQUAL(0, mbr.frameCount());
+
+    // a count that disagrees with the file size is rejected too
+    index.frameCount = 3;
+    writeIndex(&index, sizeof(index));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+
+    // a truncated file is rejected
+    index = validIndex();
+    writeIndex(&index, sizeof(index) - 4);
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+    writeIndex(&index, 8);
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+}
+
+void test_load_index_with_bad_entries_fails()
+{
+    Quest_MappedBitReader mbr;
+    TEST_ASSERT_TRUE(mbr.open(capturePath));
+
+    IndexFile index = validIndex();
+    index.entries[3] = BUFFER_SIZE_IN_BITS;
+    writeIndex(&index, sizeof(index));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+    TEST_ASSERT_EQUAL(0, mbr.frameCount());
+
+    index = validIndex();
+    index.entries[2] = index.entries[1];
+    writeIndex(&index, sizeof(index));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+
+    index = validIndex();
+    index.entries[2] = index.entries[0];
+    writeIndex(&index, sizeof(index));
+    TEST_ASSERT_FALSE(mbr.loadFrameIndex());
+    TEST_ASSERT_EQUAL(0, mbr.frameCount());
+}
+
+int main(int argc, char **argv)
+{
+    srand(1);
+    close(mkstemp(capturePath));
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_open_maps_full_capture);
+    RUN_TEST(test_open_missing_file_fails);
+    RUN_TEST(test_open_empty_capture);
+    RUN_TEST(test_read_bits_matches_bit_reader);
+    RUN_TEST(test_reads_wider_than_32_bits_match_bit_reader);
+    RUN_TEST(test_read_bit_matches_bit_reader);
+    RUN_TEST(test_read_buffer_matches_bit_reader);
+    RUN_TEST(test_read_buffer_is_clamped_to_capture);
+    RUN_TEST(test_build_save_and_load_frame_index);
+    RUN_TEST(test_seek_to_frame);
+    RUN_TEST(test_load_missing_index_fails);
+    RUN_TEST(test_load_valid_index);
+    RUN_TEST(test_load_stale_index_fails);
+    RUN_TEST(test_load_index_with_corrupt_frame_count_fails);
+    RUN_TEST(test_load_index_with_bad_entries_fails);
+
+    int result = UNITY_END();
+    unlink(capturePath);
+    return result;
+}
@@ -0,0 +1,161 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "Quest_MultiLaneBitReader.h"
+#include "Quest_BitReader.h"
+
+#define BUFFER_SIZE 48
+#define BUFFER_SIZE_IN_BITS BUFFER_SIZE * 8
+
+uint8_t buffers[QBB_LANES][BUFFER_SIZE];
+
+void randomizeBuffers()
+{
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+        {
+            buffers[lane][i] = random(256);
+        }
+    }
+}
+
+void test_new_instance_has_empty_lanes()
+{
+    Quest_MultiLaneBitReader mr = Quest_MultiLaneBitReader();
+    uint32_t values[QBB_LANES];
+    mr.readBits(8, values);
+
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        TEST_ASSERT_EQUAL(0, mr.bitCount[lane]);
+        TEST_ASSERT_EQUAL(0, mr.bitsRemaining(lane));
+        TEST_ASSERT_EQUAL(0, values[lane]);
+    }
+}
+
+void test_reset_lane_to_less_and_more_than_buffer_size()
+{
+    Quest_MultiLaneBitReader mr = Quest_MultiLaneBitReader();
+    mr.setLane(0, buffers[0], BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS, mr.bitCount[0]);
+
+    TEST_ASSERT_TRUE(mr.reset(0, 20));
+    TEST_ASSERT_EQUAL(20, mr.bitsRemaining(0));
+
+    TEST_ASSERT_FALSE(mr.reset(0, BUFFER_SIZE_IN_BITS + 1));
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS, mr.bitsRemaining(0));
+}
+
+void test_reading_lanes_in_lockstep()
+{
+    Quest_MultiLaneBitReader mr = Quest_MultiLaneBitReader();
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        buffers[lane][0] = 0b10110000 | lane;
+        mr.setLane(lane, buffers[lane], BUFFER_SIZE);
+    }
+
+    uint32_t values[QBB_LANES];
+    mr.readBits(4, values);
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        TEST_ASSERT_EQUAL(0b1011, values[lane]);
+    }
+
+    bool bits[QBB_LANES];
+    mr.readBits(2, values);
+    mr.readBit(bits);
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        TEST_ASSERT_EQUAL(lane >> 2, values[lane]);
+        TEST_ASSERT_EQUAL((lane >> 1) & 1, bits[lane]);
+        TEST_ASSERT_EQUAL(7, mr.bitPosition[lane]);
+    }
+}
+
+void test_reading_matches_single_lane_reader()
+{
+    randomizeBuffers();
+
+    Quest_MultiLaneBitReader mr = Quest_MultiLaneBitReader();
+    Quest_BitReader *readers[QBB_LANES];
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        // lanes have different lengths so some run out before others
+        uint8_t bufferLength = BUFFER_SIZE - lane * 3;
+        mr.setLane(lane, buffers[lane], bufferLength);
+        readers[lane] = new Quest_BitReader(buffers[lane], bufferLength);
+    }
+
+    uint32_t values[QBB_LANES];
+    for (uint16_t i = 0; i < 40; i++)
+    {
+        uint8_t bitsToRead = random(1, 33);
+        mr.readBits(bitsToRead, values);
+        for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+        {
+            TEST_ASSERT_EQUAL(readers[lane]->readBits(bitsToRead), values[lane]);
+            TEST_ASSERT_EQUAL(readers[lane]->bitPosition, mr.bitPosition[lane]);
+        }
+    }
+
+    for (uint8_t lane = 0; lane < QBB_LANES; lane++)
+    {
+        delete readers[lane];
+    }
+}
+
+void test_zero_returned_for_bits_read_past_available()
+{
+    Quest_MultiLaneBitReader mr = Quest_MultiLaneBitReader();
+    buffers[0][0] = 0b10101010;
+    mr.setLane(0, buffers[0], BUFFER_SIZE);
+    mr.reset(0, 4);
+
+    uint32_t values[QBB_LANES];
+    mr.readBits(8, values);
+    TEST_ASSERT_EQUAL(0b1010, values[0]);
+    TEST_ASSERT_EQUAL(0, mr.bitsRemaining(0));
+
+    mr.readBits(8, values);
+    TEST_ASSERT_EQUAL(0, values[0]);
+    TEST_ASSERT_EQUAL(4, mr.bitPosition[0]);
+}
+
+void test_reads_wider_than_32_bits_are_clamped()
+{
+    Quest_MultiLaneBitReader mr = Quest_MultiLaneBitReader();
+    buffers[0][0] = 0x12;
+    buffers[0][1] = 0x34;
+    buffers[0][2] = 0x56;
+    buffers[0][3] = 0x78;
+    buffers[0][4] = 0x9A;
+    mr.setLane(0, buffers[0], BUFFER_SIZE);
+
+    uint32_t values[QBB_LANES];
+    mr.readBits(40, values);
+    TEST_ASSERT_EQUAL(0x12345678, values[0]);
+    TEST_ASSERT_EQUAL(32, mr.bitPosition[0]);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE_IN_BITS - 32, mr.bitsRemaining(0));
+}
+
+void setup()
+{
+    delay(4000);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_new_instance_has_empty_lanes);
+    RUN_TEST(test_reset_lane_to_less_and_more_than_buffer_size);
+    RUN_TEST(test_reading_lanes_in_lockstep);
+    RUN_TEST(test_reading_matches_single_lane_reader);
+    RUN_TEST(test_zero_returned_for_bits_read_past_available);
+    RUN_TEST(test_reads_wider_than_32_bits_are_clamped);
+
+    UNITY_END();
+}
+
+void loop()
+{
+}
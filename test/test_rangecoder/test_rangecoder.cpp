@@ -0,0 +1,194 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include "Quest_RangeEncoder.h"
+#include "Quest_RangeDecoder.h"
+
+#define BUFFER_SIZE 200
+#define BUFFER_SIZE_IN_BITS BUFFER_SIZE * 8
+#define FLAG_COUNT 1000
+#define TREE_BITS 4
+
+uint8_t buffer[BUFFER_SIZE];
+bool flags[FLAG_COUNT];
+uint16_t encodeProbabilities[1 << TREE_BITS];
+uint16_t decodeProbabilities[1 << TREE_BITS];
+
+void randomizeFlags(uint8_t percentSet)
+{
+    for (uint16_t i = 0; i < FLAG_COUNT; i++)
+    {
+        flags[i] = random(100) < percentSet;
+    }
+}
+
+void test_new_encoder_writes_nothing_until_flushed()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_RangeEncoder encoder = Quest_RangeEncoder(&bw);
+    TEST_ASSERT_EQUAL(0, bw.bitsWritten());
+
+    uint16_t probability = QRC_PROBABILITY_INIT;
+    TEST_ASSERT_TRUE(encoder.encodeBit(&probability, true));
+    TEST_ASSERT_EQUAL(0, bw.bitsWritten());
+
+    // flushing writes whole bytes
+    TEST_ASSERT_TRUE(encoder.flush());
+    TEST_ASSERT_EQUAL(32, bw.bitsWritten());
+}
+
+void test_probabilities_adapt_to_bits()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_RangeEncoder encoder = Quest_RangeEncoder(&bw);
+
+    uint16_t probability;
+    resetProbabilities(&probability, 1);
+    TEST_ASSERT_EQUAL(QRC_PROBABILITY_INIT, probability);
+
+    encoder.encodeBit(&probability, false);
+    TEST_ASSERT_GREATER_OR_EQUAL(QRC_PROBABILITY_INIT + 1, probability);
+
+    resetProbabilities(&probability, 1);
+    encoder.encodeBit(&probability, true);
+    TEST_ASSERT_LESS_THAN(QRC_PROBABILITY_INIT, probability);
+}
+
+void test_encode_and_decode_skewed_flags()
+{
+    randomizeFlags(5);
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_RangeEncoder encoder = Quest_RangeEncoder(&bw);
+    uint16_t probability = QRC_PROBABILITY_INIT;
+    for (uint16_t i = 0; i < FLAG_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(encoder.encodeBit(&probability, flags[i]));
+    }
+    TEST_ASSERT_TRUE(encoder.flush());
+
+    // mostly clear flags should take far less than a bit each
+    TEST_ASSERT_LESS_THAN(FLAG_COUNT / 2, bw.bitsWritten());
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_RangeDecoder decoder = Quest_RangeDecoder(&br);
+    TEST_ASSERT_TRUE(decoder.reset());
+    probability = QRC_PROBABILITY_INIT;
+    for (uint16_t i = 0; i < FLAG_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(flags[i], decoder.decodeBit(&probability));
+    }
+}
+
+void test_encode_and_decode_after_other_bits()
+{
+    randomizeFlags(50);
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    bw.writeBits(0b101, 3);
+    Quest_RangeEncoder encoder = Quest_RangeEncoder(&bw);
+    uint16_t probability = QRC_PROBABILITY_INIT;
+    for (uint16_t i = 0; i < 200; i++)
+    {
+        encoder.encodeBit(&probability, flags[i]);
+    }
+    encoder.flush();
+    bw.writeBits(0b0110, 4);
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_RangeDecoder decoder = Quest_RangeDecoder(&br);
+    TEST_ASSERT_EQUAL(0b101, br.readBits(3));
+    TEST_ASSERT_TRUE(decoder.reset());
+    probability = QRC_PROBABILITY_INIT;
+    for (uint16_t i = 0; i < 200; i++)
+    {
+        TEST_ASSERT_EQUAL(flags[i], decoder.decodeBit(&probability));
+    }
+    TEST_ASSERT_EQUAL(0b0110, br.readBits(4));
+    TEST_ASSERT_EQUAL(0, br.bitsRemaining());
+}
+
+void test_encode_and_decode_bit_trees_and_direct_bits()
+{
+    uint8_t deltas[100];
+    uint32_t directBits[100];
+    for (uint8_t i = 0; i < 100; i++)
+    {
+        // small deltas are much more common than large ones
+        deltas[i] = (random(10) == 0) ? random(1 << TREE_BITS) : random(2);
+        directBits[i] = random(1 << 10);
+    }
+
+    Quest_BitWriter bw = Quest_BitWriter(buffer, BUFFER_SIZE);
+    Quest_RangeEncoder encoder = Quest_RangeEncoder(&bw);
+    resetProbabilities(encodeProbabilities, 1 << TREE_BITS);
+    for (uint8_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_TRUE(encoder.encodeBitTree(encodeProbabilities, TREE_BITS, deltas[i]));
+        TEST_ASSERT_TRUE(encoder.encodeDirectBits(directBits[i], 10));
+    }
+    TEST_ASSERT_TRUE(encoder.flush());
+
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(bw.bitsWritten());
+    Quest_RangeDecoder decoder = Quest_RangeDecoder(&br);
+    TEST_ASSERT_TRUE(decoder.reset());
+    resetProbabilities(decodeProbabilities, 1 << TREE_BITS);
+    for (uint8_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL(deltas[i], decoder.decodeBitTree(decodeProbabilities, TREE_BITS));
+        TEST_ASSERT_EQUAL(directBits[i], decoder.decodeDirectBits(10));
+    }
+}
+
+void test_encoding_past_buffer_end_fails()
+{
+    Quest_BitWriter bw = Quest_BitWriter(buffer, 4);
+    Quest_RangeEncoder encoder = Quest_RangeEncoder(&bw);
+
+    bool encoded = true;
+    for (uint8_t i = 0; i < 100 && encoded; i++)
+    {
+        encoded = encoder.encodeDirectBits(random(256), 8);
+    }
+    TEST_ASSERT_FALSE(encoded);
+}
+
+void test_decoder_reset_needs_four_bytes()
+{
+    Quest_BitReader br = Quest_BitReader(buffer, BUFFER_SIZE);
+    br.reset(31);
+    Quest_RangeDecoder decoder = Quest_RangeDecoder(&br);
+    TEST_ASSERT_EQUAL(0, br.bitPosition);
+    TEST_ASSERT_FALSE(decoder.reset());
+
+    // only reset reads from the reader
+    br.reset(64);
+    Quest_RangeDecoder anotherDecoder = Quest_RangeDecoder(&br);
+    TEST_ASSERT_EQUAL(0, br.bitPosition);
+    TEST_ASSERT_TRUE(anotherDecoder.reset());
+    TEST_ASSERT_EQUAL(32, br.bitPosition);
+}
+
+void setup()
+{
+    delay(4000);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_new_encoder_writes_nothing_until_flushed);
+    RUN_TEST(test_probabilities_adapt_to_bits);
+    RUN_TEST(test_encode_and_decode_skewed_flags);
+    RUN_TEST(test_encode_and_decode_after_other_bits);
+    RUN_TEST(test_encode_and_decode_bit_trees_and_direct_bits);
+    RUN_TEST(test_encoding_past_buffer_end_fails);
+    RUN_TEST(test_decoder_reset_needs_four_bytes);
+
+    UNITY_END();
+}
+
+void loop()
+{
+}